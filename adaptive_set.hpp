@@ -0,0 +1,97 @@
+#ifndef ADAPTIVE_SET_HPP
+#define ADAPTIVE_SET_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// A set of unique elements sorted with Cmp that changes its
+// representation with its size.  A small set is a sorted vector,
+// which is compact and fast to iterate, and a large set is std::set,
+// which is fast to insert into.  The set becomes indexed (std::set)
+// when its size exceeds Threshold, and then stays indexed.  The set
+// only grows: it stores the permanent labels, which are never erased.
+//
+// We do not offer iterators, because they would have to dispatch on
+// the representation at every step.  Use visit instead, which calls
+// the given function with the container of the current
+// representation.
+//
+// A reference to an element is valid until the next insertion.
+template <typename T, typename Cmp, std::size_t Threshold>
+struct adaptive_set
+{
+  static_assert(Threshold > 0);
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using linear_type = std::vector<T>;
+  using indexed_type = std::set<T, Cmp>;
+
+  std::variant<linear_type, indexed_type> m_c;
+
+  size_type
+  size() const
+  {
+    return visit([](const auto &c){return c.size();});
+  }
+
+  bool
+  empty() const
+  {
+    return !size();
+  }
+
+  bool
+  is_linear() const
+  {
+    return m_c.index() == 0;
+  }
+
+  template <typename F>
+  decltype(auto)
+  visit(F &&f) const
+  {
+    return std::visit(std::forward<F>(f), m_c);
+  }
+
+  // Inserts element t, which must not be in the set yet, and returns
+  // a reference to the inserted element.
+  template <typename U>
+  const T &
+  insert(U &&t)
+  {
+    if (auto *v = std::get_if<linear_type>(&m_c))
+      {
+        if (v->size() < Threshold)
+          {
+            auto i = std::upper_bound(v->begin(), v->end(), t, Cmp());
+            assert(i == v->begin() || Cmp()(*std::prev(i), t));
+            return *v->insert(i, std::forward<U>(t));
+          }
+
+        to_indexed();
+      }
+
+    auto [i, s] = std::get<indexed_type>(m_c).insert(std::forward<U>(t));
+    assert(s);
+    return *i;
+  }
+
+private:
+  void
+  to_indexed()
+  {
+    auto &v = std::get<linear_type>(m_c);
+    indexed_type s(std::make_move_iterator(v.begin()),
+                   std::make_move_iterator(v.end()));
+    m_c = std::move(s);
+  }
+};
+
+#endif // ADAPTIVE_SET_HPP
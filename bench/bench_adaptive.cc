@@ -0,0 +1,80 @@
+#include "bench_graph.hpp"
+
+#include "generic_adaptive_permanent.hpp"
+#include "generic_permanent2.hpp"
+#include "generic_tentative.hpp"
+
+// Compares generic_permanent2 (std::set per vertex) with
+// generic_adaptive_permanent (a sorted vector per vertex, std::set
+// past the threshold) for a few thresholds, and for a few graph and
+// spectrum profiles.  All containers produce the same permanent
+// labels, and so the number of labels should be the same.  A key in
+// std::set compares the labels with the boe kernels, as
+// generic_permanent2 does, and so the thresholds differ in how long a
+// key stays a vector only.
+
+using namespace std;
+
+template <typename F>
+void
+report(const string &graph, const string &spectrum, const string &container,
+       unsigned sources, F f)
+{
+  std::size_t count = 0;
+  double t = bench_time([&]
+  {
+    for(unsigned s = 0; s < sources; ++s)
+      count += f(s);
+  });
+
+  cout << setw(12) << graph << setw(8) << spectrum << setw(14) << container
+       << setw(12) << fixed << setprecision(2) << t / sources << " ms"
+       << setw(12) << count / sources << " labels" << endl;
+}
+
+template <std::size_t Threshold>
+void
+report_adaptive(const string &name, const bench_graph &g,
+                const bench_spectrum &s, unsigned sources, const CU &r,
+                const bench_functor &f)
+{
+  using permanent = generic_adaptive_permanent<bench_label, Threshold>;
+
+  report(name, s.m_name, "adaptive/" + to_string(Threshold), sources,
+         [&](unsigned src)
+         {
+           generic_tentative<bench_label> T(g.size());
+           return bench_search<permanent>(g, src, r, f, T);
+         });
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  report(name, s.m_name, "permanent2", sources, [&](unsigned src)
+  {
+    generic_tentative<bench_label> T(g.size());
+    return bench_search<generic_permanent2<bench_label>>(g, src, r, f, T);
+  });
+
+  report_adaptive<16>(name, g, s, sources, r, f);
+  report_adaptive<64>(name, g, s, sources, r, f);
+  report_adaptive<256>(name, g, s, sources, r, f);
+  report_adaptive<1024>(name, g, s, sources, r, f);
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,66 @@
+#include "bench_graph.hpp"
+
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+// Compares a search for every target of an anycast demand with one
+// search for all targets together.
+
+using namespace std;
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned src = 0;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+  bench_edge ie(g[src], g[src], 0, r);
+  const bench_label initial({0, r}, ie);
+
+  // The targets spread over the graph.
+  vector<unsigned> dsts;
+  for(unsigned i = 1; i <= 4; ++i)
+    dsts.push_back(i * (g.size() - 1) / 4);
+
+  size_t c1 = 0, c2 = 0;
+
+  double t1 = bench_time([&]
+  {
+    for(auto dst: dsts)
+      {
+        generic_permanent<bench_label> P(g.size());
+        generic_tentative<bench_label> T(g.size());
+        for([[maybe_unused]] const auto &l:
+              generic_search(P, T, f, initial, dst))
+          ++c1;
+      }
+  });
+
+  double t2 = bench_time([&]
+  {
+    generic_permanent<bench_label> P(g.size());
+    generic_tentative<bench_label> T(g.size());
+    for([[maybe_unused]] const auto &l:
+          generic_multi_search(P, T, f, {initial}, search_targets(dsts)))
+      ++c2;
+  });
+
+  cout << setw(8) << name << setw(8) << s.m_name
+       << setw(10) << fixed << setprecision(2) << t1 << " ms "
+       << dsts.size() << " searches" << setw(6) << c1 << " labels"
+       << setw(10) << t2 << " ms anycast" << setw(6) << c2 << " labels"
+       << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,63 @@
+#include "bench_graph.hpp"
+
+#include "generic_band_search.hpp"
+#include "generic_permanent.hpp"
+#include "generic_tentative.hpp"
+
+#include <cstddef>
+
+// Compares one search with the searches of k spectrum bands run on
+// separate threads.  The band searches pay off for wide spectra,
+// where a label has many boe-incomparable labels.
+
+using namespace std;
+
+using permanent = generic_permanent<bench_label>;
+using tentative = generic_tentative<bench_label>;
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 3;
+  const unsigned width = 4;
+  const CU r(0, s.m_slots);
+  const bench_functor f{width};
+
+  for(size_t k: {1, 2, 4, 8})
+    {
+      size_t count = 0;
+
+      double t = bench_time([&]
+      {
+        for(unsigned src = 0; src < sources; ++src)
+          {
+            // The initial edge is a loop at the source.
+            bench_edge ie(g[src], g[src], 0, r);
+            auto initial = [&](const CU &b)
+            {
+              return bench_label({0, b}, ie);
+            };
+
+            auto result = generic_band_search<permanent, tentative>
+              (g.size(), f, initial, r, width, k, g.size() - 1 - src);
+            count += result.m_labels.size();
+          }
+      });
+
+      cout << setw(12) << name << setw(8) << s.m_name << setw(4) << k
+           << setw(12) << fixed << setprecision(2) << t / sources << " ms"
+           << setw(8) << count << " labels" << endl;
+    }
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,78 @@
+#include "bench_graph.hpp"
+
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <cassert>
+
+// Compares generic_search that pushes the candidate labels into
+// generic_tentative one by one with the search that pushes them in a
+// batch, for graphs of growing degree.  Both find the same labels.
+
+using namespace std;
+
+// The tentative labels that cannot take a batch, so that the search
+// pushes the labels one by one.
+struct one_by_one: generic_tentative<bench_label>
+{
+  using generic_tentative<bench_label>::generic_tentative;
+
+  size_t
+  push_batch(std::vector<bench_label> &) = delete;
+};
+
+template <typename Tentative>
+size_t
+run(const bench_graph &g, const CU &r, const bench_functor &f,
+    unsigned sources, double &t)
+{
+  size_t count = 0;
+
+  t = bench_time([&]
+  {
+    for(unsigned src = 0; src < sources; ++src)
+      {
+        generic_permanent<bench_label> P(g.size());
+        Tentative T(g.size());
+        bench_edge ie(g[src], g[src], 0, r);
+        unsigned dst = g.size() - 1 - src;
+
+        for([[maybe_unused]] const auto &l:
+              generic_search(P, T, f, bench_label({0, r}, ie), dst))
+          ++count;
+      }
+  });
+
+  return count;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  double t1, t2;
+  auto c1 = run<one_by_one>(g, r, f, sources, t1);
+  auto c2 = run<generic_tentative<bench_label>>(g, r, f, sources, t2);
+  assert(c1 == c2);
+
+  cout << setw(12) << name << setw(8) << s.m_name
+       << setw(12) << fixed << setprecision(2) << t1 / sources
+       << " ms one by one"
+       << setw(12) << t2 / sources << " ms batch" << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    for(unsigned degree: {4, 16, 64})
+      {
+        mt19937 gen(1);
+        bench("degree " + to_string(degree),
+              random_graph(200, degree, s, gen), s);
+      }
+}
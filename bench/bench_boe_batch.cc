@@ -0,0 +1,174 @@
+#include "bench_graph.hpp"
+
+#include "generic_boe_batch.hpp"
+#include "generic_permanent.hpp"
+#include "generic_permanent2.hpp"
+#include "generic_pipeline.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+// Compares the searches whose containers compare the labels with the
+// boe kernels in the columns they keep, with the searches whose
+// containers compare the labels with boe one by one.  Both find the
+// same labels.  Then compares the kernels with boe for the labels of
+// a single key, for CU and SU.
+
+using namespace std;
+
+// The label that the kernels do not compare.
+struct scalar_label: bench_label
+{
+  using bench_label::bench_label;
+};
+
+template <>
+inline constexpr bool boe_kernels_enabled<scalar_label> = false;
+
+static_assert(generic_tentative<bench_label>::columnar);
+static_assert(!generic_tentative<scalar_label>::columnar);
+
+template <typename Label, template <typename> typename Permanent>
+size_t
+run(const bench_graph &g, const CU &r, unsigned sources, double &t)
+{
+  const auto f = creator<Label> | width_filter<4>;
+  size_t count = 0;
+
+  t = bench_time([&]
+  {
+    for(unsigned src = 0; src < sources; ++src)
+      {
+        Permanent<Label> P(g.size());
+        generic_tentative<Label> T(g.size());
+        bench_edge ie(g[src], g[src], 0, r);
+        unsigned dst = g.size() - 1 - src;
+
+        for([[maybe_unused]] const auto &l:
+              generic_search(P, T, f, Label({0, r}, ie), dst))
+          ++count;
+      }
+  });
+
+  return count;
+}
+
+template <typename Label>
+using permanent = generic_permanent<Label>;
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+
+  double t1, t2, t3, t4;
+  auto c1 = run<scalar_label, permanent>(g, r, sources, t1);
+  auto c2 = run<bench_label, permanent>(g, r, sources, t2);
+  auto c3 = run<scalar_label, generic_permanent2>(g, r, sources, t3);
+  auto c4 = run<bench_label, generic_permanent2>(g, r, sources, t4);
+  assert(c1 == c2 && c2 == c3 && c3 == c4);
+
+  cout << setw(12) << name << setw(8) << s.m_name
+       << setw(10) << fixed << setprecision(2) << t1 / sources
+       << " ms boe" << setw(10) << t2 / sources << " ms kernels"
+       << setw(10) << t3 / sources << " ms boe2"
+       << setw(10) << t4 / sources << " ms kernels2" << endl;
+}
+
+// Compares label j with the n labels of c for every label j of js,
+// with boe one by one, and with the kernels.
+template <typename Label>
+void
+bench_key(const string &name, const vector<Label> &c,
+          const vector<Label> &js)
+{
+  boe_columns<Label> columns;
+  for(const auto &l: c)
+    columns.push_back(l);
+
+  auto at = [&c](size_t i) -> const Label & {return c[i];};
+  size_t n1 = 0, n2 = 0;
+
+  auto t1 = bench_time([&]
+  {
+    for(const auto &j: js)
+      n1 += any_of(c.begin(), c.end(), [&j](const auto &i)
+      {
+        return boe(i, j);
+      });
+  });
+
+  auto t2 = bench_time([&]
+  {
+    for(const auto &j: js)
+      n2 += boe_any(columns, c.size(), j, at);
+  });
+
+  assert(n1 == n2);
+
+  cout << setw(12) << name << setw(8) << c.size()
+       << setw(10) << fixed << setprecision(2) << t1
+       << " ms boe" << setw(10) << t2 << " ms kernels" << endl;
+}
+
+// Two contiguous resources, if they do not overlap, or one.
+SU
+random_su(const bench_spectrum &s, mt19937 &gen)
+{
+  auto a = random_cu(s, gen), b = random_cu(s, gen);
+
+  if (a.max() < b.min() || b.max() < a.min())
+    return SU{a, b};
+
+  return SU{a};
+}
+
+void
+bench_keys()
+{
+  using cu_label = generic_label<unsigned, CU>;
+  using su_label = generic_label<unsigned, SU>;
+
+  mt19937 gen(1);
+  const bench_spectrum s = {"wide", 320, 20, 160};
+  uniform_int_distribution<unsigned> wd(0, 1000);
+
+  for(size_t n: {8, 64, 512})
+    {
+      // The comparisons are mostly false, so every label is compared.
+      vector<cu_label> cc, cj;
+      vector<su_label> sc, sj;
+
+      for(size_t i = 0; i < n; ++i)
+        {
+          cc.emplace_back(wd(gen), random_cu(s, gen));
+          sc.emplace_back(wd(gen), random_su(s, gen));
+        }
+
+      for(size_t i = 0; i < 100000; ++i)
+        {
+          cj.emplace_back(wd(gen), random_cu(s, gen));
+          sj.emplace_back(wd(gen), random_su(s, gen));
+        }
+
+      bench_key("CU", cc, cj);
+      bench_key("SU", sc, sj);
+    }
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    for(unsigned degree: {4, 16})
+      {
+        mt19937 gen(1);
+        bench("degree " + to_string(degree),
+              random_graph(200, degree, s, gen), s);
+      }
+
+  bench_keys();
+}
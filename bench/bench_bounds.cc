@@ -0,0 +1,182 @@
+#include "bench_graph.hpp"
+
+#include "generic_bounds.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <queue>
+
+// Compares the search with no bounds, with the weight limit, and with
+// the hop limit.  The search runs to the end, and yields all labels
+// of the target.
+
+using namespace std;
+
+// The label of the benchmarks that counts its hops.
+struct bench_hop_label: generic_hop_label<unsigned, CU>, key<unsigned>
+{
+  using label_type = generic_hop_label<unsigned, CU>;
+
+  const bench_edge *m_edge;
+
+  bench_hop_label(const label_type &l, const bench_edge &e):
+    label_type(l), key<unsigned>(get_key(get_target(e))), m_edge(&e)
+  {
+  }
+
+  bool operator == (const bench_hop_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l);
+  }
+
+  auto operator <=> (const bench_hop_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+inline const bench_edge &
+get_edge(const bench_hop_label &l)
+{
+  return *l.m_edge;
+}
+
+struct bench_hop_functor
+{
+  unsigned m_demand;
+
+  vector<bench_hop_label>
+  operator()(const bench_hop_label &l, const bench_edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty() || r.max() - r.min() < m_demand)
+      return {};
+
+    return {bench_hop_label({w, r, get_hops(l) + 1}, e)};
+  }
+};
+
+// The fewest hops from vertex src to vertex dst.
+unsigned
+min_hops(const bench_graph &g, unsigned src, unsigned dst)
+{
+  vector<unsigned> hops(g.size(), ~0U);
+  queue<unsigned> q;
+  hops[src] = 0;
+  q.push(src);
+
+  while(!q.empty())
+    {
+      unsigned v = q.front();
+      q.pop();
+      for(const auto &e: get_edges(g[v]))
+        if (unsigned t = get_key(get_target(e)); hops[t] == ~0U)
+          {
+            hops[t] = hops[v] + 1;
+            q.push(t);
+          }
+    }
+
+  return hops[dst];
+}
+
+// Searches to the end, and returns the number of the permanent
+// labels, the number of the labels of the target, and the weight of
+// the lightest label of the target (or 0).
+template <typename Label, typename Functor>
+tuple<size_t, size_t, unsigned>
+search(const bench_graph &g, unsigned src, unsigned dst, const CU &r,
+       const Functor &f, const Label &initial)
+{
+  generic_permanent<Label> P(g.size());
+  generic_tentative<Label> T(g.size());
+
+  size_t labels = 0;
+  unsigned w = 0;
+  for(const auto &l: generic_search(P, T, f, initial, dst))
+    if (!labels++)
+      w = get_weight(l);
+
+  size_t count = 0;
+  for(unsigned i = 0; i < g.size(); ++i)
+    count += P[i].size();
+
+  return {count, labels, w};
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const CU r(0, s.m_slots);
+  const unsigned width = 4;
+  // Far from the source in the grid and around the ring.
+  const unsigned src = 0, dst = g.size() / 2;
+  bench_edge ie(g[src], g[src], 0, r);
+  const bench_label initial({0, r}, ie);
+  const bench_hop_label hop_initial({0, r, 0}, ie);
+
+  cout << setw(8) << name << setw(8) << s.m_name;
+
+  auto report = [](const auto &s, double t, const auto &res)
+  {
+    cout << setw(10) << fixed << setprecision(2) << t << " ms " << s
+         << setw(8) << get<0>(res) << setw(4) << get<1>(res);
+  };
+
+  tuple<size_t, size_t, unsigned> res;
+  double t = bench_time([&]
+  {
+    res = search(g, src, dst, r, bench_functor{width}, initial);
+  });
+  report("none", t, res);
+
+  // No path: nothing to bound.
+  if (!get<2>(res))
+    {
+      cout << endl;
+      return;
+    }
+
+  // Up to a fifth heavier than the lightest.
+  search_bounds<unsigned> wb{get<2>(res) * 6 / 5};
+  t = bench_time([&]
+  {
+    res = search(g, src, dst, r, bounded_functor(bench_functor{width}, wb),
+                 initial);
+  });
+  report("weight", t, res);
+
+  // The hops with no limit, and then with the limit of two hops more
+  // than the fewest.
+  t = bench_time([&]
+  {
+    res = search(g, src, dst, r, bench_hop_functor{width}, hop_initial);
+  });
+  report("hops", t, res);
+
+  search_bounds<unsigned> hb{.m_max_hops = min_hops(g, src, dst) + 2};
+  t = bench_time([&]
+  {
+    res = search(g, src, dst, r,
+                 bounded_functor(bench_hop_functor{width}, hb), hop_initial);
+  });
+  report("hop limit", t, res);
+
+  cout << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(20, 20, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(500, 8, s, gen), s);
+    }
+}
@@ -0,0 +1,133 @@
+#include "bench_graph.hpp"
+
+#include "generic_compressed_permanent.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <cassert>
+
+// Compares the memory taken by the permanent labels of the one-to-all
+// search with the memory taken by their compressed copy, and the time
+// of has_better_or_equal, and of tracing the paths, for both.
+
+using namespace std;
+
+// The edge of a label is encoded with its key, and the initial edge
+// with the number of edges.
+struct bench_codec
+{
+  vector<const bench_edge *> m_edges;
+
+  compressed_fields
+  encode(const bench_label &l) const
+  {
+    auto k = get_key(get_edge(l));
+    return {get_weight(l), get_resources(l).min(), get_resources(l).max(),
+            k == ~0U ? m_edges.size() - 1 : k};
+  }
+
+  bench_label
+  decode(const compressed_fields &f, size_t) const
+  {
+    return bench_label({unsigned(f.m_weight), CU(f.m_min, f.m_max)},
+                       *m_edges[f.m_edge]);
+  }
+};
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned src = 0;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  bench_edge ie(g[src], g[src], 0, r);
+  const bench_label initial({0, r}, ie);
+
+  generic_permanent<bench_label> P(g.size());
+  generic_tentative<bench_label> T(g.size());
+  // There is no vertex of key g.size(), and so we search all.
+  for([[maybe_unused]] const auto &l:
+        generic_search(P, T, f, initial, g.size()))
+    ;
+
+  bench_codec c;
+  c.m_edges.resize(g.m_edge_count + 1);
+  for(const auto &v: g)
+    for(const auto &e: get_edges(v))
+      c.m_edges[get_key(e)] = &e;
+  c.m_edges.back() = &ie;
+
+  size_t count = 0, bytes = P.size() * sizeof(P[0]);
+  for(const auto &vd: P)
+    {
+      count += vd.size();
+      bytes += vd.capacity() * sizeof(bench_label);
+    }
+
+  generic_compressed_permanent<bench_label, bench_codec> *pc = nullptr;
+  double tc = bench_time([&]
+  {
+    pc = new generic_compressed_permanent<bench_label, bench_codec>(P, c);
+  });
+  const auto &C = *pc;
+  assert(C.label_count() == count);
+
+  // Every label has itself to be better than or equal to it.
+  auto boe_all = [&](const auto &Q)
+  {
+    return bench_time([&]
+    {
+      for(const auto &vd: P)
+        for(const auto &l: vd)
+          {
+            [[maybe_unused]] bool b = has_better_or_equal(Q, l);
+            assert(b);
+          }
+    });
+  };
+
+  // The path of the first label of every vertex.
+  auto paths = [&](const auto &Q, size_t &hops)
+  {
+    return bench_time([&]
+    {
+      hops = 0;
+      for(const auto &vd: P)
+        if (!vd.empty())
+          for([[maybe_unused]] const auto &l:
+                generic_path_range(Q, f, vd.front(), initial))
+            ++hops;
+    });
+  };
+
+  double tb1 = boe_all(P), tb2 = boe_all(C);
+  size_t h1, h2;
+  double tp1 = paths(P, h1), tp2 = paths(C, h2);
+  assert(h1 == h2);
+
+  cout << setw(8) << name << setw(8) << s.m_name
+       << setw(8) << count << " labels"
+       << setw(7) << fixed << setprecision(1)
+       << double(bytes) / count << " B/label"
+       << setw(8) << double(C.bytes()) / count << " B/label compressed"
+       << setw(8) << setprecision(2) << tc << " ms compress"
+       << setw(8) << tb1 << setw(8) << tb2 << " ms boe"
+       << setw(8) << tp1 << setw(8) << tp2 << " ms paths" << endl;
+
+  delete pc;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,123 @@
+#include "bench_graph.hpp"
+
+#include "generic_contraction.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <cassert>
+
+// Compares the queries of the contraction hierarchy with the search
+// of generic Dijkstra, and reports the times of the preprocessing,
+// and of the customization after the resources of a few edges
+// changed.  Both find the same number of target labels.
+//
+// The queries win when the resources are scarce, since then the
+// shortcuts have a few witnesses.  When they are plentiful, the
+// shortcuts of distant vertexes have many witnesses, the up searches
+// grow with them, and generic Dijkstra is faster.  The changes of a
+// few edges propagate to most shortcuts, and then the customization
+// takes as long as the preprocessing.
+
+using namespace std;
+
+void
+bench(const string &name, bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned queries = 20;
+  const unsigned demand = 4;
+  const CU r(0, s.m_slots);
+  const bench_functor f{demand};
+  auto fits = [&](const CU &cr){return cr.max() - cr.min() >= demand;};
+
+  auto neighbours = [&](size_t v)
+  {
+    vector<size_t> ns;
+    for(const auto &e: get_edges(g[v]))
+      ns.push_back(get_key(get_target(e)));
+    return ns;
+  };
+
+  double tp;
+  auto cch = [&]
+  {
+    auto t0 = chrono::steady_clock::now();
+    generic_cch<unsigned, CU> cch(g, min_degree_order(g.size(),
+                                                      neighbours));
+    tp = chrono::duration<double, milli>(chrono::steady_clock::now()
+                                         - t0).count();
+    return cch;
+  }();
+
+  mt19937 gen(1);
+  uniform_int_distribution<unsigned> vd(0, g.size() - 1);
+  vector<pair<unsigned, unsigned>> pairs;
+  for(unsigned i = 0; i < queries; ++i)
+    pairs.emplace_back(vd(gen), vd(gen));
+
+  size_t cd = 0, cc = 0;
+
+  double td = bench_time([&]
+  {
+    for(auto [src, dst]: pairs)
+      {
+        generic_permanent<bench_label> P(g.size());
+        generic_tentative<bench_label> T(g.size());
+        bench_edge ie(g[src], g[src], 0, r);
+        for([[maybe_unused]] const auto &l:
+              generic_search(P, T, f, bench_label({0, r}, ie), dst))
+          ++cd;
+      }
+  });
+
+  double tq = bench_time([&]
+  {
+    for(auto [src, dst]: pairs)
+      if (src != dst)
+        cc += cch_query(cch, src, dst, r, fits).m_labels.size();
+      else
+        ++cc;
+  });
+
+  assert(cd == cc);
+
+  // The resources of a few edges change: they lose their last slot.
+  double tc = bench_time([&]
+  {
+    for(unsigned i = 0; i < 10; ++i)
+      {
+        auto &v = g[vd(gen)];
+        if (v.m_edges.empty())
+          continue;
+        auto &e = v.m_edges.front();
+        auto er = get_resources(e);
+        if (er.max() - er.min() > 1)
+          {
+            e = bench_edge(get_source(e), get_target(e), get_weight(e),
+                           CU(er.min(), er.max() - 1), get_key(e));
+            cch.update(e);
+          }
+      }
+    cch.customize();
+  });
+
+  cout << setw(12) << name << setw(8) << s.m_name
+       << setw(12) << fixed << setprecision(2) << tp << " ms prep"
+       << setw(12) << tc << " ms custom"
+       << setw(12) << td / queries << " ms dijkstra"
+       << setw(12) << tq / queries << " ms cch"
+       << setw(8) << cc << " labels" << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      auto grid = grid_graph(20, 20, s, gen);
+      bench("grid", grid, s);
+      auto sparse = random_graph(500, 3, s, gen);
+      bench("sparse", sparse, s);
+    }
+}
@@ -0,0 +1,135 @@
+#include "bench_graph.hpp"
+
+#include "generic_disjoint.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+// Compares the search for disjoint pairs with the loop that removes
+// the edges of a working path and searches again, for the next
+// working path until a protection path is found.
+
+using namespace std;
+
+// The functor that skips the removed edges.
+struct removed_functor
+{
+  bench_functor m_f;
+  const vector<bool> &m_removed;
+
+  bench_candidates
+  operator()(const bench_label &l, const bench_edge &e) const
+  {
+    if (get_key(e) != ~0U && m_removed[get_key(e)])
+      return {};
+
+    return m_f(l, e);
+  }
+};
+
+// The weight of the pair of the remove-and-repeat loop, or 0 if no
+// pair was found.
+unsigned
+repeat(const bench_graph &g, unsigned src, unsigned dst, const CU &r,
+       unsigned width)
+{
+  const bench_functor f{width};
+  bench_edge ie(g[src], g[src], 0, r);
+  const bench_label initial({0, r}, ie);
+
+  generic_permanent<bench_label> P(g.size());
+  generic_tentative<bench_label> T(g.size());
+
+  for(const auto &l: generic_search(P, T, f, initial, dst))
+    {
+      vector<bool> removed(g.m_edge_count);
+      for(const auto &pl: generic_path_range(P, f, l, initial))
+        removed[get_key(get_edge(pl))] = true;
+
+      removed_functor rf{f, removed};
+      generic_permanent<bench_label> P2(g.size());
+      generic_tentative<bench_label> T2(g.size());
+      for(const auto &l2: generic_search(P2, T2, rf, initial, dst))
+        return get_weight(l) + get_weight(l2);
+    }
+
+  return 0;
+}
+
+// The demands spread over the graph.
+vector<pair<unsigned, unsigned>>
+demands(const bench_graph &g)
+{
+  vector<pair<unsigned, unsigned>> ds;
+  for(unsigned i = 0; i < 8; ++i)
+    ds.emplace_back(i * g.size() / 16, g.size() - 1 - i * g.size() / 16);
+
+  return ds;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const CU r(0, s.m_slots);
+  const unsigned width = 4;
+  const auto ds = demands(g);
+
+  // The weights of the pairs of the loop.
+  vector<unsigned> ws;
+  size_t n = 0;
+
+  double t = bench_time([&]
+  {
+    for(auto [src, dst]: ds)
+      ws.push_back(repeat(g, src, dst, r, width));
+  });
+
+  for(auto w: ws)
+    n += w != 0;
+
+  cout << setw(8) << name << setw(8) << s.m_name
+       << setw(10) << fixed << setprecision(2) << t << " ms repeat"
+       << setw(3) << n << " found";
+
+  // For the given numbers of working paths: the demands with a pair,
+  // and with a pair lighter than the one of the loop (or with a pair
+  // where the loop found none), and the number of pairs.
+  for(size_t working: {1, 4})
+    {
+      size_t found = 0, lighter = 0, pairs = 0;
+
+      double t = bench_time([&]
+      {
+        for(size_t i = 0; i < ds.size(); ++i)
+          {
+            auto ps = generic_approx_disjoint_pairs
+              (g, ds[i].first, ds[i].second, r, width, working);
+            if (ps.empty())
+              continue;
+
+            ++found;
+            pairs += ps.size();
+            lighter += !ws[i] || ps[0].m_weight < ws[i];
+          }
+      });
+
+      cout << setw(10) << t << " ms" << setw(2) << working << " working"
+           << setw(3) << found << " found" << setw(3) << lighter
+           << " lighter" << setw(5) << pairs << " pairs";
+    }
+
+  cout << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(10, 10, s, gen), s);
+      bench("sparse", random_graph(200, 4, s, gen), s);
+      bench("dense", random_graph(100, 8, s, gen), s);
+    }
+}
@@ -0,0 +1,316 @@
+#ifndef BENCH_GRAPH_HPP
+#define BENCH_GRAPH_HPP
+
+#include "generic_label.hpp"
+#include "generic_label_creator.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "props.hpp"
+#include "units.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The graph, the labels, and the search loop that the benchmarks
+// share.  The graph has just enough of the graph interface for the
+// generic containers and functions.
+
+struct bench_vertex;
+
+struct bench_edge: weight<unsigned>, resources<CU>
+{
+  const bench_vertex *m_source;
+  const bench_vertex *m_target;
+  // The key of the edge.  The initial loop edges have none.
+  unsigned m_key;
+
+  bench_edge(const bench_vertex &s, const bench_vertex &t,
+             unsigned w, const CU &r, unsigned key = ~0U):
+    weight<unsigned>(w), resources<CU>(r), m_source(&s), m_target(&t),
+    m_key(key)
+  {
+  }
+
+  // The edges are the same if they are the same object.  A member, so
+  // that it hides the operators of the properties.
+  bool
+  operator == (const bench_edge &e) const
+  {
+    return this == &e;
+  }
+};
+
+struct bench_vertex
+{
+  unsigned m_key;
+  // The out-edges.
+  std::vector<bench_edge> m_edges;
+
+  // The vertexes are the same if they are the same object.
+  bool
+  operator == (const bench_vertex &v) const
+  {
+    return this == &v;
+  }
+};
+
+inline const bench_vertex &
+get_source(const bench_edge &e)
+{
+  return *e.m_source;
+}
+
+inline const bench_vertex &
+get_target(const bench_edge &e)
+{
+  return *e.m_target;
+}
+
+inline unsigned
+get_key(const bench_vertex &v)
+{
+  return v.m_key;
+}
+
+inline unsigned
+get_key(const bench_edge &e)
+{
+  return e.m_key;
+}
+
+inline const auto &
+get_edges(const bench_vertex &v)
+{
+  return v.m_edges;
+}
+
+// The vertexes must not move once the edges refer to them, and so we
+// create all of them in the constructor.
+struct bench_graph: std::vector<bench_vertex>
+{
+  // The number of edges, which is also the key of the next edge.
+  unsigned m_edge_count = 0;
+
+  bench_graph(unsigned count)
+  {
+    reserve(count);
+    for(unsigned i = 0; i < count; ++i)
+      push_back(bench_vertex{i, {}});
+  }
+
+  void
+  add_edge(unsigned s, unsigned t, unsigned w, const CU &r)
+  {
+    auto &v = operator[](s);
+    v.m_edges.emplace_back(v, operator[](t), w, r, m_edge_count++);
+  }
+};
+
+// The label of the benchmarks: the key is the key of the target of
+// the edge.
+struct bench_label: generic_label<unsigned, CU>, key<unsigned>
+{
+  using label_type = generic_label<unsigned, CU>;
+
+  const bench_edge *m_edge;
+
+  bench_label(const label_type &l, const bench_edge &e):
+    label_type(l), key<unsigned>(get_key(get_target(e))), m_edge(&e)
+  {
+  }
+
+  // The edge and the key do not take part in comparisons.
+  bool operator == (const bench_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l);
+  }
+
+  auto operator <=> (const bench_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+inline const bench_edge &
+get_edge(const bench_label &l)
+{
+  return *l.m_edge;
+}
+
+// The candidate labels of a relaxation: none or one.
+struct bench_candidates
+{
+  std::optional<bench_label> m_l;
+
+  bench_label *
+  begin()
+  {
+    return m_l ? &*m_l : nullptr;
+  }
+
+  bench_label *
+  end()
+  {
+    return m_l ? &*m_l + 1 : nullptr;
+  }
+};
+
+// Produces the candidate label for a label and an edge.  The
+// candidate is discarded if its resources cannot fit the demand.
+struct bench_functor
+{
+  unsigned m_demand;
+
+  bench_candidates
+  operator()(const bench_label &l, const bench_edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty() || r.max() - r.min() < m_demand)
+      return {};
+
+    return {bench_label({w, r}, e)};
+  }
+};
+
+// The profile of the spectrum of edges: the number of slots, and the
+// range of the widths of the free contiguous slots of an edge.
+struct bench_spectrum
+{
+  std::string m_name;
+  unsigned m_slots;
+  unsigned m_min_width;
+  unsigned m_max_width;
+};
+
+inline CU
+random_cu(const bench_spectrum &s, std::mt19937 &gen)
+{
+  std::uniform_int_distribution<unsigned> wd(s.m_min_width, s.m_max_width);
+  unsigned w = wd(gen);
+  std::uniform_int_distribution<unsigned> md(0, s.m_slots - w);
+  unsigned min = md(gen);
+
+  return CU(min, min + w);
+}
+
+inline void
+add_edges(bench_graph &g, unsigned a, unsigned b,
+          const bench_spectrum &s, std::mt19937 &gen)
+{
+  std::uniform_int_distribution<unsigned> wd(1, 100);
+  unsigned w = wd(gen);
+  g.add_edge(a, b, w, random_cu(s, gen));
+  g.add_edge(b, a, w, random_cu(s, gen));
+}
+
+// A grid of rows x cols vertexes: sparse and of large diameter.
+inline bench_graph
+grid_graph(unsigned rows, unsigned cols, const bench_spectrum &s,
+           std::mt19937 &gen)
+{
+  bench_graph g(rows * cols);
+
+  for(unsigned r = 0; r < rows; ++r)
+    for(unsigned c = 0; c < cols; ++c)
+      {
+        if (c + 1 < cols)
+          add_edges(g, r * cols + c, r * cols + c + 1, s, gen);
+        if (r + 1 < rows)
+          add_edges(g, r * cols + c, (r + 1) * cols + c, s, gen);
+      }
+
+  return g;
+}
+
+// A ring with random chords, so that every vertex has about the given
+// degree: of small diameter, and denser with larger degrees.
+inline bench_graph
+random_graph(unsigned count, unsigned degree, const bench_spectrum &s,
+             std::mt19937 &gen)
+{
+  bench_graph g(count);
+  std::uniform_int_distribution<unsigned> vd(0, count - 1);
+
+  for(unsigned i = 0; i < count; ++i)
+    add_edges(g, i, (i + 1) % count, s, gen);
+
+  for(unsigned i = 0; i < count * (degree - 2) / 2; ++i)
+    if (unsigned a = vd(gen), b = vd(gen); a != b)
+      add_edges(g, a, b, s, gen);
+
+  return g;
+}
+
+// The search loop of generic Dijkstra: from vertex src, with the
+// given initial resources, for the given containers and functor.
+// Returns the number of permanent labels.
+template <typename Permanent, typename Tentative, typename Functor>
+auto
+bench_search(const bench_graph &g, unsigned src, const CU &r,
+             const Functor &f, Tentative &T)
+{
+  Permanent P(g.size());
+  // The initial edge is a loop at the source.
+  bench_edge ie(g[src], g[src], 0, r);
+  T.push(bench_label({0, r}, ie));
+
+  std::size_t count = 0;
+
+  while(true)
+    {
+      // The lazy tentative labels drop the dominated labels here.
+      if constexpr (requires {T.purge(P);})
+        T.purge(P);
+
+      if (T.empty())
+        break;
+
+      const auto &l = P.push(T.pop());
+      ++count;
+
+      // The lazy tentative labels always say they have no better or
+      // equal label, and drop the dominated labels later.
+      const auto fl = label_functor(f, l);
+      for(const auto &e: get_edges(get_target(get_edge(l))))
+        for(auto &c: fl(e))
+          if (!has_better_or_equal(P, c) && !has_better_or_equal(T, c))
+            T.push(std::move(c));
+    }
+
+  return count;
+}
+
+// Runs function f, and returns the time it took in milliseconds.
+template <typename F>
+double
+bench_time(F f)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  f();
+  auto t1 = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// The spectrum profiles the benchmarks run for.
+inline std::vector<bench_spectrum>
+bench_spectra()
+{
+  // A few slots, most of them free on every edge.
+  return {{"narrow", 64, 16, 64},
+          // Many slots, some of them free on every edge.
+          {"wide", 320, 20, 160},
+          // Many slots, most of them free on every edge.
+          {"free", 320, 160, 320}};
+}
+
+#endif // BENCH_GRAPH_HPP
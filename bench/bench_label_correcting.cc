@@ -0,0 +1,90 @@
+#include "bench_graph.hpp"
+
+#include "generic_label_correcting.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <cassert>
+
+// Compares the label-setting search (generic_search) with the
+// label-correcting search of the FIFO and the SLF order, for the
+// classes of topologies, so that we can choose the search for a
+// class.  All find the same labels of the target.
+//
+// Most of the gain of the label-correcting search on the random
+// graphs comes from dropping the labels that a label of the target
+// is better than or equal to, which generic_search does not do.
+
+using namespace std;
+
+template <typename F>
+size_t
+run(const bench_graph &g, const CU &r, unsigned sources, double &t, F f)
+{
+  size_t count = 0;
+
+  t = bench_time([&]
+  {
+    for(unsigned src = 0; src < sources; ++src)
+      {
+        bench_edge ie(g[src], g[src], 0, r);
+        unsigned dst = g.size() - 1 - src;
+        count += f(bench_label({0, r}, ie), dst);
+      }
+  });
+
+  return count;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  double t1, t2, t3;
+
+  auto c1 = run(g, r, sources, t1, [&](const auto &initial, unsigned dst)
+  {
+    generic_permanent<bench_label> P(g.size());
+    generic_tentative<bench_label> T(g.size());
+    for([[maybe_unused]] const auto &l:
+          generic_search(P, T, f, initial, dst))
+      ;
+    return P[dst].size();
+  });
+
+  auto lc = [&](lc_order order)
+  {
+    return [&, order](const auto &initial, unsigned dst)
+    {
+      generic_pareto<bench_label> P(g.size());
+      generic_label_correcting(P, f, initial, dst, order);
+      return P[dst].size();
+    };
+  };
+
+  auto c2 = run(g, r, sources, t2, lc(lc_order::fifo));
+  auto c3 = run(g, r, sources, t3, lc(lc_order::slf));
+  assert(c1 == c2 && c1 == c3);
+
+  cout << setw(14) << name << setw(8) << s.m_name
+       << setw(10) << fixed << setprecision(2) << t1 / sources
+       << " ms setting"
+       << setw(10) << t2 / sources << " ms fifo"
+       << setw(10) << t3 / sources << " ms slf" << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid 20x20", grid_graph(20, 20, s, gen), s);
+      bench("random 200/4", random_graph(200, 4, s, gen), s);
+      bench("random 200/16", random_graph(200, 16, s, gen), s);
+    }
+}
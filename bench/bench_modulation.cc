@@ -0,0 +1,114 @@
+#include "bench_graph.hpp"
+
+#include "generic_bounds.hpp"
+#include "generic_modulation.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+// Compares a search per modulation format with the single search for
+// all formats.  The searches run to the end, and yield all labels of
+// the target.
+
+using namespace std;
+
+// The functor of the single search.
+struct modulation_functor
+{
+  generic_modulation_creator<unsigned> m_c;
+
+  bench_candidates
+  operator()(const bench_label &l, const bench_edge &e) const
+  {
+    auto [w, r] = m_c(l, e);
+
+    if (r.empty())
+      return {};
+
+    return {bench_label({w, r}, e)};
+  }
+};
+
+// Searches to the end, and returns the number of the permanent labels
+// and the labels of the target.
+template <typename Functor>
+pair<size_t, vector<bench_label>>
+search(const bench_graph &g, unsigned src, unsigned dst,
+       const bench_label &initial, const Functor &f)
+{
+  generic_permanent<bench_label> P(g.size());
+  generic_tentative<bench_label> T(g.size());
+
+  vector<bench_label> ls;
+  for(const auto &l: generic_search(P, T, f, initial, dst))
+    ls.push_back(l);
+
+  size_t count = 0;
+  for(unsigned i = 0; i < g.size(); ++i)
+    count += P[i].size();
+
+  return {count, ls};
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s,
+      const modulation_table<unsigned> &t)
+{
+  const CU r(0, s.m_slots);
+  // Far from the source in the grid and around the ring.
+  const unsigned src = 0, dst = g.size() / 2;
+  bench_edge ie(g[src], g[src], 0, r);
+  const bench_label initial({0, r}, ie);
+
+  // The labels, and the formats with a path.
+  size_t labels = 0, formats = 0;
+
+  double t1 = bench_time([&]
+  {
+    for(const auto &fm: t.m_formats)
+      {
+        bounded_functor f(bench_functor{fm.m_width},
+                          search_bounds<unsigned>{fm.m_reach});
+        auto [count, ls] = search(g, src, dst, initial, f);
+        labels += count;
+        formats += !ls.empty();
+      }
+  });
+
+  cout << setw(8) << name << setw(8) << s.m_name
+       << setw(10) << fixed << setprecision(2) << t1 << " ms per format"
+       << setw(8) << labels << setw(3) << formats;
+
+  labels = formats = 0;
+  double t2 = bench_time([&]
+  {
+    auto [count, ls] = search(g, src, dst, initial, modulation_functor{t});
+    labels = count;
+
+    // The formats that some label of the target can use.
+    vector<bool> fs(t.m_formats.size());
+    for(const auto &l: ls)
+      for(const auto &fm: t.formats(get_weight(l), get_resources(l)))
+        fs[&fm - t.m_formats.data()] = true;
+    formats = ranges::count(fs, true);
+  });
+
+  cout << setw(10) << t2 << " ms single" << setw(8) << labels
+       << setw(3) << formats << endl;
+}
+
+int
+main()
+{
+  // The more efficient formats reach shorter.
+  const modulation_table<unsigned> t({{500, 4}, {1000, 8}, {2000, 12},
+                                      {4000, 16}});
+
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(20, 20, s, gen), s, t);
+      bench("sparse", random_graph(1000, 4, s, gen), s, t);
+      bench("dense", random_graph(500, 8, s, gen), s, t);
+    }
+}
@@ -0,0 +1,125 @@
+#include "bench_graph.hpp"
+
+#include "generic_pipeline.hpp"
+#include "generic_permanent.hpp"
+#include "generic_tentative.hpp"
+
+#include <cassert>
+#include <functional>
+
+// Compares the functor composed at compile time with the functor of
+// the same checks in runtime layers (each a std::function on the
+// (weight, resources) pair of generic_label_creator), and with the
+// hand-written functor.  All find the same labels.
+
+using namespace std;
+
+using candidate = pair<unsigned, CU>;
+
+struct layered_functor
+{
+  vector<function<bool(const candidate &)>> m_layers;
+
+  bench_candidates
+  operator()(const bench_label &l, const bench_edge &e) const
+  {
+    auto p = generic_label_creator()(l, e);
+
+    if (p.second.empty())
+      return {};
+
+    for(const auto &f: m_layers)
+      if (!f(p))
+        return {};
+
+    return {bench_label(std::move(p), e)};
+  }
+};
+
+// The hand-written functor of the same checks.
+struct capped_functor
+{
+  unsigned m_cap;
+  size_t *m_count;
+
+  bench_candidates
+  operator()(const bench_label &l, const bench_edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty())
+      return {};
+
+    ++*m_count;
+
+    if (r.max() - r.min() < 4 || w > m_cap)
+      return {};
+
+    return {bench_label({w, r}, e)};
+  }
+};
+
+template <typename Functor>
+size_t
+run(const bench_graph &g, const CU &r, const Functor &f,
+    unsigned sources, double &t)
+{
+  size_t count = 0;
+
+  t = bench_time([&]
+  {
+    for(unsigned src = 0; src < sources; ++src)
+      {
+        generic_tentative<bench_label> T(g.size());
+        count += bench_search<generic_permanent<bench_label>>(g, src, r, f,
+                                                             T);
+      }
+  });
+
+  return count;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+  // Large enough to leave most labels.
+  const unsigned cap = 3000;
+
+  // The candidates counted for stats by every functor.
+  size_t n1 = 0, n2 = 0, n3 = 0;
+
+  layered_functor f1{{[&n1](const candidate &) {++n1; return true;},
+                      [](const candidate &p)
+                      {return p.second.max() - p.second.min() >= 4;},
+                      [cap](const candidate &p) {return p.first <= cap;}}};
+  const auto f2 = creator<bench_label> | candidate_counter{&n2}
+    | width_filter<4> | weight_cap(cap);
+  capped_functor f3{cap, &n3};
+
+  double t1, t2, t3;
+  auto c1 = run(g, r, f1, sources, t1);
+  auto c2 = run(g, r, f2, sources, t2);
+  auto c3 = run(g, r, f3, sources, t3);
+  assert(c1 == c2 && c2 == c3);
+  assert(n1 == n2 && n2 == n3);
+
+  cout << setw(12) << name << setw(8) << s.m_name
+       << setw(12) << fixed << setprecision(2) << t1 / sources
+       << " ms layers"
+       << setw(12) << t2 / sources << " ms pipeline"
+       << setw(12) << t3 / sources << " ms hand-written" << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    for(unsigned degree: {4, 16})
+      {
+        mt19937 gen(1);
+        bench("degree " + to_string(degree),
+              random_graph(200, degree, s, gen), s);
+      }
+}
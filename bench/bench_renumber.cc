@@ -0,0 +1,133 @@
+#include "bench_graph.hpp"
+
+#include "generic_permanent.hpp"
+#include "generic_renumbering.hpp"
+#include "generic_tentative.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+// Compares the search on a graph whose keys are shuffled with the
+// search on the same graph renumbered in the BFS and the RCM orders.
+// The graphs are the same up to the keys, and so the searches find
+// the same labels.  The labels found for the renumbered graph are
+// looked up with the original keys.
+//
+// The orders gain a few percent on large sparse graphs only, because
+// the search spends most of its time on comparing labels, and not on
+// reaching them.
+
+using namespace std;
+
+using permanent = generic_permanent<bench_label>;
+
+// The graph g with the vertexes renumbered with r.
+bench_graph
+renumbered(const bench_graph &g, const vertex_renumbering &r)
+{
+  bench_graph h(g.size());
+
+  renumber_edges(g, r, [&h](size_t s, size_t t, const bench_edge &e)
+  {
+    h.add_edge(s, t, get_weight(e), get_resources(e));
+  });
+
+  return h;
+}
+
+// The number of labels of every vertex, indexed with the original key.
+vector<size_t>
+counts(const permanent &P, const vertex_renumbering &r)
+{
+  vector<size_t> c;
+  for(size_t i = 0; i < P.size(); ++i)
+    c.push_back(P[r.to_new(i)].size());
+  return c;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 2;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  // The original graph, with the keys shuffled.
+  vector<size_t> order(g.size());
+  iota(order.begin(), order.end(), 0);
+  mt19937 gen(1);
+  ranges::shuffle(order, gen);
+  vertex_renumbering shuffled(std::move(order));
+  auto sg = renumbered(g, shuffled);
+
+  // The orders are found for the shuffled graph.
+  auto sneighbours = [&](size_t v)
+  {
+    vector<size_t> ns;
+    for(const auto &e: get_edges(sg[v]))
+      ns.push_back(get_key(get_target(e)));
+    return ns;
+  };
+
+  vector<size_t> identity(sg.size());
+  iota(identity.begin(), identity.end(), 0);
+
+  vector<pair<string, vertex_renumbering>> orders;
+  orders.emplace_back("shuffled", vertex_renumbering(identity));
+  orders.emplace_back("bfs", bfs_renumbering(sg.size(), sneighbours));
+  orders.emplace_back("rcm", rcm_renumbering(sg.size(), sneighbours));
+
+  vector<size_t> reference;
+
+  for(const auto &[o, rn]: orders)
+    {
+      auto h = renumbered(sg, rn);
+
+      double t = bench_time([&]
+      {
+        for(unsigned src = 0; src < sources; ++src)
+          {
+            generic_tentative<bench_label> T(h.size());
+            bench_search<permanent>(h, rn.to_new(src), r, f, T);
+          }
+      });
+
+      // The labels of source 0, looked up with the shuffled keys.
+      permanent P(h.size());
+      {
+        bench_edge ie(h[rn.to_new(0)], h[rn.to_new(0)], 0, r);
+        generic_tentative<bench_label> T(h.size());
+        T.push(bench_label({0, r}, ie));
+        while(!T.empty())
+          {
+            const auto &l = P.push(T.pop());
+            for(const auto &e: get_edges(get_target(get_edge(l))))
+              for(auto &c: f(l, e))
+                if (!has_better_or_equal(P, c) &&
+                    !has_better_or_equal(T, c))
+                  T.push(std::move(c));
+          }
+      }
+
+      auto c = counts(P, rn);
+      if (reference.empty())
+        reference = c;
+      assert(c == reference);
+
+      cout << setw(12) << name << setw(8) << s.m_name << setw(10) << o
+           << setw(12) << fixed << setprecision(2) << t / sources << " ms"
+           << endl;
+    }
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(40, 40, s, gen), s);
+      bench("sparse", random_graph(10000, 3, s, gen), s);
+    }
+}
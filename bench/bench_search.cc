@@ -0,0 +1,67 @@
+#include "bench_graph.hpp"
+
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <cstddef>
+#include <functional>
+
+// Compares the time it takes to get the first one or two labels of
+// the target with generic_search, and the time of the complete
+// search.
+
+using namespace std;
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  // The number of labels we take: none means all.
+  for(size_t n: {1, 2, 0})
+    {
+      size_t count = 0;
+
+      double t = bench_time([&]
+      {
+        for(unsigned src = 0; src < sources; ++src)
+          {
+            generic_permanent<bench_label> P(g.size());
+            generic_tentative<bench_label> T(g.size());
+            // The initial edge is a loop at the source.
+            bench_edge ie(g[src], g[src], 0, r);
+            // The target is at the other end of the graph.
+            unsigned dst = g.size() - 1 - src;
+
+            size_t i = 0;
+            for([[maybe_unused]] const auto &l:
+                  generic_search(P, T, f,
+                                 bench_label({0, r}, ie), dst))
+              if (++i == n)
+                break;
+
+            count += i;
+          }
+      });
+
+      cout << setw(12) << name << setw(8) << s.m_name
+           << setw(8) << (n ? to_string(n) : "all")
+           << setw(12) << fixed << setprecision(2) << t / sources << " ms"
+           << setw(8) << count << " labels" << endl;
+    }
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,143 @@
+#include "bench_graph.hpp"
+
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_snapshot.hpp"
+#include "generic_tentative.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+// Compares the time of the one-to-all search with the time of saving
+// its labels to a snapshot, and of loading them from the mapped
+// snapshot.  The loaded labels must be the labels of the search, and
+// their paths must be the same.
+
+using namespace std;
+
+// The record of a bench label: the edge is the index of the edge
+// among the out-edges of its source, or ~0 for the initial edge.
+struct bench_record
+{
+  unsigned m_w;
+  unsigned m_min;
+  unsigned m_max;
+  unsigned m_source;
+  unsigned m_edge;
+};
+
+uint64_t
+fingerprint(const bench_graph &g)
+{
+  snapshot_fingerprint fp;
+  fp.add(g.size());
+
+  for(const auto &v: g)
+    for(const auto &e: get_edges(v))
+      fp.add(get_key(get_target(e))).add(get_weight(e))
+        .add(get_resources(e).min()).add(get_resources(e).max());
+
+  return fp.value();
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned src = 0;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+  const string path = "bench_snapshot.bin";
+
+  // The initial edge is a loop at the source.
+  bench_edge ie(g[src], g[src], 0, r);
+  const bench_label initial({0, r}, ie);
+
+  generic_permanent<bench_label> P(g.size());
+
+  double ts = bench_time([&]
+  {
+    generic_tentative<bench_label> T(g.size());
+    // There is no vertex of key g.size(), and so we search all.
+    for([[maybe_unused]] const auto &l:
+          generic_search(P, T, f, initial, g.size()))
+      ;
+  });
+
+  auto encode = [&](const bench_label &l)
+  {
+    const auto &e = get_edge(l);
+    const auto &es = get_edges(get_source(e));
+    unsigned i = &e == &ie ? ~0U : &e - es.data();
+
+    return bench_record{get_weight(l), get_resources(l).min(),
+                        get_resources(l).max(), get_key(get_source(e)), i};
+  };
+
+  auto decode = [&](const bench_record &rec)
+  {
+    const auto &e = rec.m_edge == ~0U ? ie :
+      get_edges(g[rec.m_source])[rec.m_edge];
+    return bench_label({rec.m_w, CU(rec.m_min, rec.m_max)}, e);
+  };
+
+  double tw = bench_time([&]
+  {
+    ofstream out(path, ios::binary);
+    save_snapshot(out, P, encode, fingerprint(g));
+  });
+
+  generic_permanent<bench_label> Q(g.size());
+
+  double tl = bench_time([&]
+  {
+    snapshot_mapping m(path);
+    generic_snapshot_view<bench_record> v(m.bytes(), fingerprint(g));
+    load_snapshot(Q, v, decode);
+  });
+
+  remove(path.c_str());
+
+  // The labels and their paths must be the same.
+  size_t count = 0;
+  for(size_t i = 0; i < g.size(); ++i)
+    {
+      assert(P[i].size() == Q[i].size());
+
+      for(size_t j = 0; j < P[i].size(); ++j)
+        {
+          assert(P[i][j] == Q[i][j]);
+          assert(&get_edge(P[i][j]) == &get_edge(Q[i][j]));
+          ++count;
+        }
+
+      if (!Q[i].empty())
+        {
+          vector<const bench_edge *> p, q;
+          for(const auto &l: generic_path_range(P, f, P[i].front(), initial))
+            p.push_back(&get_edge(l));
+          for(const auto &l: generic_path_range(Q, f, Q[i].front(), initial))
+            q.push_back(&get_edge(l));
+          assert(p == q);
+        }
+    }
+
+  cout << setw(12) << name << setw(8) << s.m_name
+       << setw(12) << fixed << setprecision(2) << ts << " ms search"
+       << setw(12) << tw << " ms save"
+       << setw(12) << tl << " ms load"
+       << setw(10) << count << " labels" << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,110 @@
+#include "bench_graph.hpp"
+
+#include "generic_edge_summary.hpp"
+#include "generic_permanent.hpp"
+#include "generic_tentative.hpp"
+
+// Compares the functor that intersects the resources of every label
+// and edge with the functor that first checks their summaries.  Both
+// produce the same labels.
+//
+// For contiguous resources, the intersection is two comparisons, and
+// so the summaries do not pay off, even when most relaxations are
+// rejected.  They are for the resources of many runs, whose
+// intersection builds a set.
+
+using namespace std;
+
+using permanent = generic_permanent<bench_label>;
+
+// As bench_functor, but with generic_summary_creator.
+struct bench_summary_functor
+{
+  generic_summary_creator m_c;
+
+  bench_candidates
+  operator()(const bench_label &l, const bench_edge &e) const
+  {
+    return candidates(m_c(l, e), e);
+  }
+
+  // The summary of label l is computed once for all its edges.
+  auto
+  for_label(const bench_label &l) const
+  {
+    return [this, c = m_c.for_label(l)](const bench_edge &e)
+    {
+      return candidates(c(e), e);
+    };
+  }
+
+  bench_candidates
+  candidates(const pair<unsigned, CU> &p, const bench_edge &e) const
+  {
+    const auto &[w, r] = p;
+
+    if (r.empty() || r.max() - r.min() < m_c.m_width)
+      return {};
+
+    return {bench_label({w, r}, e)};
+  }
+};
+
+template <typename F>
+void
+report(const string &graph, const string &spectrum, const string &functor,
+       unsigned sources, F f)
+{
+  std::size_t count = 0;
+  double t = bench_time([&]
+  {
+    for(unsigned s = 0; s < sources; ++s)
+      count += f(s);
+  });
+
+  cout << setw(12) << graph << setw(8) << spectrum << setw(10) << functor
+       << setw(12) << fixed << setprecision(2) << t / sources << " ms"
+       << setw(12) << count / sources << " labels" << endl;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const unsigned demand = 4;
+  const CU r(0, s.m_slots);
+
+  generic_edge_summaries summaries(g.m_edge_count, s.m_slots);
+  for(const auto &v: g)
+    for(const auto &e: get_edges(v))
+      summaries.update(e);
+
+  report(name, s.m_name, "plain", sources, [&](unsigned src)
+  {
+    generic_tentative<bench_label> T(g.size());
+    return bench_search<permanent>(g, src, r, bench_functor{demand}, T);
+  });
+
+  report(name, s.m_name, "summary", sources, [&](unsigned src)
+  {
+    generic_tentative<bench_label> T(g.size());
+    bench_summary_functor f{{summaries, demand}};
+    return bench_search<permanent>(g, src, r, f, T);
+  });
+}
+
+int
+main()
+{
+  auto spectra = bench_spectra();
+  // A few slots, and a few of them free on every edge.
+  spectra.push_back({"loaded", 64, 6, 16});
+
+  for(const auto &s: spectra)
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,67 @@
+#include "bench_graph.hpp"
+
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_telemetry.hpp"
+#include "generic_tentative.hpp"
+
+// Compares the search without a probe with the search that records
+// its telemetry, and shows the histograms of the records.
+
+using namespace std;
+
+template <typename Probe>
+double
+run(const bench_graph &g, const CU &r, const bench_functor &f,
+    unsigned sources)
+{
+  return bench_time([&]
+  {
+    for(unsigned src = 0; src < sources; ++src)
+      {
+        generic_permanent<bench_label> P(g.size());
+        generic_tentative<bench_label> T(g.size());
+        bench_edge ie(g[src], g[src], 0, r);
+        unsigned dst = g.size() - 1 - src;
+
+        for([[maybe_unused]] const auto &l:
+              generic_search(P, T, f, bench_label({0, r}, ie), dst,
+                             Probe()))
+          ;
+      }
+  });
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 10;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  double t0 = run<null_probe>(g, r, f, sources);
+  double t1 = run<telemetry_probe>(g, r, f, sources);
+
+  cout << setw(12) << name << setw(8) << s.m_name
+       << setw(12) << fixed << setprecision(2) << t0 / sources << " ms"
+       << setw(12) << t1 / sources << " ms probed" << endl;
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+
+  auto rs = telemetry_registry::get().collect();
+  for(auto i: {1, 3, 6})
+    {
+      cout << search_record_names[i] << ":\n";
+      write_histogram(cout, histogram(rs, i));
+    }
+}
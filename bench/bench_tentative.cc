@@ -0,0 +1,72 @@
+#include "bench_graph.hpp"
+
+#include "generic_lazy_tentative.hpp"
+#include "generic_permanent.hpp"
+#include "generic_tentative.hpp"
+
+// Compares the eager generic_tentative with the lazy
+// generic_lazy_tentative (for a few compaction thresholds) for a few
+// graph and spectrum profiles.  Both policies produce the same
+// permanent labels, and so the number of labels should be the same.
+//
+// The lazy policy wins on sparse graphs (grids and sparse random
+// graphs) for all spectra, because most pushed labels become
+// permanent anyway, or are dominated at pop time.  On dense graphs
+// many pushed labels are dominated by the tentative labels, the heap
+// grows with them until they are compacted, and the eager policy is
+// about as fast.
+
+using namespace std;
+
+using permanent = generic_permanent<bench_label>;
+
+template <typename F>
+void
+report(const string &graph, const string &spectrum, const string &policy,
+       unsigned sources, F f)
+{
+  std::size_t count = 0;
+  double t = bench_time([&]
+  {
+    for(unsigned s = 0; s < sources; ++s)
+      count += f(s);
+  });
+
+  cout << setw(12) << graph << setw(8) << spectrum << setw(12) << policy
+       << setw(12) << fixed << setprecision(2) << t / sources << " ms"
+       << setw(12) << count / sources << " labels" << endl;
+}
+
+void
+bench(const string &name, const bench_graph &g, const bench_spectrum &s)
+{
+  const unsigned sources = 5;
+  const CU r(0, s.m_slots);
+  const bench_functor f{4};
+
+  report(name, s.m_name, "eager", sources, [&](unsigned src)
+  {
+    generic_tentative<bench_label> T(g.size());
+    return bench_search<permanent>(g, src, r, f, T);
+  });
+
+  for(auto th: {16, 64, 256})
+    report(name, s.m_name, "lazy/" + to_string(th), sources,
+           [&](unsigned src)
+           {
+             generic_lazy_tentative<bench_label> T(g.size(), th);
+             return bench_search<permanent>(g, src, r, f, T);
+           });
+}
+
+int
+main()
+{
+  for(const auto &s: bench_spectra())
+    {
+      mt19937 gen(1);
+      bench("grid", grid_graph(30, 30, s, gen), s);
+      bench("sparse", random_graph(1000, 4, s, gen), s);
+      bench("dense", random_graph(200, 16, s, gen), s);
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef GENERIC_ADAPTIVE_PERMANENT_HPP
+#define GENERIC_ADAPTIVE_PERMANENT_HPP
+
+#include "adaptive_set.hpp"
+#include "generic_permanent2.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// The container type for storing permanent generic labels as
+// generic_permanent2 does, i.e., sorted with generic_permanent2_cmp,
+// but every key starts with its labels in a sorted vector, and
+// switches to std::set only when it has more than Threshold labels.
+// Most keys have a few labels only, and for them the vector is
+// smaller and faster to search, while the hub keys with many labels
+// keep the cheaper insertion of std::set.
+//
+// Searching the labels of a key costs more than inserting a label, so
+// the vector pays off up to a few hundred labels: in bench_adaptive,
+// where both representations compare with the boe kernels, the
+// threshold of 256 was the fastest in total, up to 1.5 times faster
+// than 16 and 64 on the grids, and about as fast as 1024.  Only on
+// the dense graph of the wide spectrum was it slower, by a third.
+//
+// For the labels that the boe kernels compare (see
+// generic_boe_batch.hpp), a key in std::set keeps the columns of its
+// labels, as generic_permanent2 does, so that has_better_or_equal
+// compares a label with them in batches.  A key gets them when it
+// switches to std::set, where the labels stay put.  The vector of the
+// keys is a protected base, and a key gives its labels read-only.
+//
+// A reference to a label is valid until the next label of the same
+// key is pushed.
+template <typename Label, std::size_t Threshold = 256>
+struct generic_adaptive_permanent:
+  protected std::vector<adaptive_set<Label, generic_permanent2_cmp<Label>,
+                                     Threshold>>
+{
+  // The label type.
+  using label_type = Label;
+  using cmp_type = generic_permanent2_cmp<label_type>;
+  // The type of data a vertex has.
+  using vd_type = adaptive_set<label_type, cmp_type, Threshold>;
+  // The base type.
+  using base = std::vector<vd_type>;
+  // The size type of the base.
+  using size_type = typename base::size_type;
+
+  using base::size;
+
+  // Do we keep the columns?
+  static constexpr bool columnar = boe_columnar<Label>;
+
+  // The columns of the labels of a key, and the labels in that order.
+  using slots_type = typename generic_permanent2<Label>::slots_type;
+
+  // The columns of every key, if columnar.  They are empty while the
+  // key is linear.
+  std::vector<slots_type> m_slots;
+
+  generic_adaptive_permanent(size_type count):
+    base(count), m_slots(columnar ? count : 0)
+  {
+  }
+
+  // The labels of the key.
+  const vd_type &
+  operator[](size_type key) const
+  {
+    return base::operator[](key);
+  }
+
+  // Pushes a new label, and returns a reference to it.
+  template <typename T>
+  const label_type &
+  push(T &&l)
+  {
+    // The key of the label.
+    const auto &ti = get_key(l);
+    // The vertex data.
+    auto &vd = base::operator[](ti);
+    bool linear = vd.is_linear();
+    // Just insert.
+    const auto &r = vd.insert(std::forward<T>(l));
+
+    if constexpr (columnar)
+      if (!vd.is_linear())
+        {
+          auto &sl = m_slots[ti];
+
+          // The key has just switched, and so all its labels enter the
+          // columns, and otherwise the new one.
+          if (linear)
+            for(const auto &i: std::get<typename vd_type::indexed_type>
+                  (vd.m_c))
+              {
+                sl.m_c.push_back(i);
+                sl.m_ls.push_back(&i);
+              }
+          else
+            {
+              sl.m_c.push_back(r);
+              sl.m_ls.push_back(&r);
+            }
+        }
+
+    return r;
+  }
+};
+
+/**
+ * Is there in P a label that is better than or equal to label j?
+ */
+template <typename Label, std::size_t Threshold>
+bool
+has_better_or_equal(const generic_adaptive_permanent<Label, Threshold> &P,
+                    const Label &j)
+{
+  const auto &vd = P[get_key(j)];
+
+  if constexpr (generic_adaptive_permanent<Label, Threshold>::columnar)
+    if (!vd.is_linear())
+      {
+        // The columns are not sorted, so we compare j with all labels
+        // of the key, but in batches.
+        const auto &sl = P.m_slots[get_key(j)];
+        return boe_any(sl.m_c, sl.m_c.size(), j,
+                       [&sl](std::size_t i) -> const Label &
+                       {
+                         return *sl.m_ls[i];
+                       });
+      }
+
+  return vd.visit([&j](const auto &c){return boe2(c, j);});
+}
+
+#endif // GENERIC_ADAPTIVE_PERMANENT_HPP
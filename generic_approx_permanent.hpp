@@ -0,0 +1,58 @@
+#ifndef GENERIC_APPROX_PERMANENT_HPP
+#define GENERIC_APPROX_PERMANENT_HPP
+
+#include "generic_permanent.hpp"
+
+#include <cstddef>
+
+// The container type for storing permanent generic labels with the
+// number of labels of a key capped.  The labels are stored as in
+// generic_permanent.  Since the labels are pushed in the order of <, a
+// key keeps the cap cheapest labels: a candidate label for a key that
+// already has cap labels is rejected.  The cap gives no error bound,
+// and so we count the labels it rejected.
+//
+// Epsilon-dominance does not belong here: the labels become permanent
+// in the order of <, and so a permanent label is never heavier than a
+// candidate label, and then eps_boe is boe.  See
+// generic_approx_tentative.
+template <typename Label>
+struct generic_approx_permanent: generic_permanent<Label>
+{
+  // The base type.
+  using base_type = generic_permanent<Label>;
+  // The size type of the base type.
+  using size_type = typename base_type::size_type;
+
+  // The maximal number of labels of a key, or 0 for no limit.
+  size_type m_cap;
+  // The number of candidate labels rejected because their key already
+  // had the maximal number of labels.  Updated by has_better_or_equal.
+  mutable std::size_t m_cap_rejected = 0;
+
+  generic_approx_permanent(size_type count, size_type cap = 0):
+    base_type(count), m_cap(cap)
+  {
+  }
+};
+
+/**
+ * Is there in P a label that is better than or equal to label j, or
+ * has the key of j reached the cap?
+ */
+template <typename Label>
+bool
+has_better_or_equal(const generic_approx_permanent<Label> &P,
+                    const Label &j)
+{
+  if (P.m_cap && P[get_key(j)].size() >= P.m_cap)
+    {
+      ++P.m_cap_rejected;
+      return true;
+    }
+
+  return has_better_or_equal
+    (static_cast<const generic_permanent<Label> &>(P), j);
+}
+
+#endif // GENERIC_APPROX_PERMANENT_HPP
@@ -0,0 +1,120 @@
+#ifndef GENERIC_APPROX_TENTATIVE_HPP
+#define GENERIC_APPROX_TENTATIVE_HPP
+
+#include "generic_label.hpp"
+#include "generic_tentative.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// The "epsilon better or equal" function generalizes boe: label i is
+// epsilon better than or equal to label j if the weight of i is at
+// most (1 + eps) times the weight of j, and the resources of i
+// include the resources of j.  For eps = 0, it is boe.
+template <typename Weight, typename Resources>
+bool
+eps_boe(const generic_label<Weight, Resources> &i,
+        const generic_label<Weight, Resources> &j, double eps)
+{
+  return get_weight(i) <= (1 + eps) * get_weight(j) &&
+    includes(get_resources(i), get_resources(j));
+}
+
+// What the approximate mode did.
+struct approx_stats
+{
+  // The number of candidate labels rejected by epsilon-dominance,
+  // i.e., those that had no better or equal label.
+  std::size_t m_eps_rejected = 0;
+  // The largest ratio of the weight of the label that rejected a
+  // candidate label to the weight of the candidate label.
+  double m_max_ratio = 1;
+};
+
+// The container type for storing tentative generic labels in the
+// approximate mode.  The labels are stored as in generic_tentative,
+// but function has_better_or_equal uses eps_boe, and so a candidate
+// label is rejected if a tentative label of its key is a bit heavier,
+// but has the resources of the candidate.  Then fewer labels become
+// permanent.
+//
+// This is where the heavier labels are: the permanent labels are not
+// heavier than a candidate label, because they become permanent in
+// the order of <.
+//
+// The labels that survive cover the rejected ones: for every label of
+// the exact search of h edges, there is a label of the approximate
+// search with its resources, and at most error_bound(h) relatively
+// heavier.
+template <typename Label>
+struct generic_approx_tentative: generic_tentative<Label>
+{
+  // The base type.
+  using base_type = generic_tentative<Label>;
+  // The size type of the base type.
+  using size_type = typename base_type::size_type;
+  // The label type.
+  using label_type = Label;
+
+  // The epsilon of eps_boe.
+  double m_eps;
+  // What we did.  Updated by has_better_or_equal.
+  mutable approx_stats m_stats;
+
+  generic_approx_tentative(size_type count, double eps):
+    base_type(count), m_eps(eps)
+  {
+  }
+
+  // The batch of generic_tentative compares the candidates with boe,
+  // and so the search should push them one by one.
+  size_type
+  push_batch(std::vector<label_type> &) = delete;
+
+  // Returns the worst-case relative cost error of a path with the
+  // given number of edges.  Every edge of a path can introduce at most
+  // the ratio of the worst rejection, and the errors multiply.
+  double
+  error_bound(size_type hops) const
+  {
+    return std::pow(m_stats.m_max_ratio, hops) - 1;
+  }
+};
+
+/**
+ * Is there in T a label that is epsilon better than or equal to label
+ * j?
+ */
+template <typename Label>
+bool
+has_better_or_equal(const generic_approx_tentative<Label> &T,
+                    const Label &j)
+{
+  for (const auto &i: T[get_key(j)])
+    {
+      // The labels are sorted with <, so the weights do not decrease.
+      // Once the weight of i is too large, it is too large for the
+      // labels that follow.  Unlike in boe, we go past j.
+      if (get_weight(i) > (1 + T.m_eps) * get_weight(j))
+        break;
+
+      if (eps_boe(i, j, T.m_eps))
+        {
+          if (get_weight(j) < get_weight(i))
+            {
+              ++T.m_stats.m_eps_rejected;
+              T.m_stats.m_max_ratio =
+                std::max(T.m_stats.m_max_ratio,
+                         double(get_weight(i)) / get_weight(j));
+            }
+
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#endif // GENERIC_APPROX_TENTATIVE_HPP
@@ -0,0 +1,174 @@
+#ifndef GENERIC_BAND_SEARCH_HPP
+#define GENERIC_BAND_SEARCH_HPP
+
+#include "generic_label.hpp"
+#include "generic_search.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Splits contiguous resources r into k bands, so that every allocation
+// of width units in r falls in one of the bands.  The allocations
+// start at one of the first n = size(r) - width + 1 units of r.  We
+// give every band a contiguous part of these starts, and so the band
+// spans its starts and the width - 1 units that follow them.  The
+// bands overlap by width - 1 units.
+//
+// There are no bands if r is narrower than width, and there are at
+// most n bands.
+template <typename Resources>
+std::vector<Resources>
+split_bands(const Resources &r, std::size_t k, unsigned width)
+{
+  std::vector<Resources> bands;
+
+  if (r.empty() || r.max() - r.min() < width)
+    return bands;
+
+  // The number of the starts.
+  std::size_t n = r.max() - r.min() - width + 1;
+  k = std::min(k, n);
+
+  for(std::size_t i = 0; i < k; ++i)
+    {
+      // The first and the one-past-the-last start of the band.
+      auto s0 = r.min() + i * n / k;
+      auto s1 = r.min() + (i + 1) * n / k;
+      bands.emplace_back(s0, s1 - 1 + width);
+    }
+
+  return bands;
+}
+
+// The result of generic_band_search.
+template <typename Permanent>
+struct generic_band_result
+{
+  // The label type.
+  using label_type = typename Permanent::label_type;
+
+  // The initial labels of the searches, one per band.
+  std::vector<label_type> m_initials;
+  // The permanent labels of the searches, one per band.
+  std::vector<Permanent> m_Ps;
+  // The target labels that are boe-incomparable, sorted with <.  For
+  // every label, we also store the band of the label, and so the
+  // path of label l of band b is given by:
+  //
+  // generic_path_range(m_Ps[b], f, *l, m_initials[b])
+  std::vector<std::pair<std::size_t, const label_type *>> m_labels;
+};
+
+// A label's resources only shrink along a path, and so a search
+// started with a band of the resources explores the labels of that
+// band only.  Here we split the initial resources r into k bands of
+// split_bands, and search every band on a separate thread.  Function
+// initial returns the initial label for the given resources.
+//
+// The bands overlap, so the searches can find the same labels, and
+// the labels of one search can be worse than or equal to the labels
+// of other searches.  We merge the target labels, and keep the
+// boe-incomparable ones.
+//
+// The merged labels cover every feasible allocation of the demand
+// width, but their resources are clipped to their bands.  Functor f
+// should reject the candidate labels narrower than the width, as it
+// should in one search.
+//
+// We throw std::invalid_argument if k is 0.  If a search throws, we
+// wait for the other searches, and rethrow the exception of the first
+// band that threw.
+template <typename Permanent, typename Tentative, typename Functor,
+          typename Initial, typename Resources, typename Key>
+auto
+generic_band_search(typename Permanent::size_type count,
+                    const Functor &f, Initial initial,
+                    const Resources &r, unsigned width, std::size_t k,
+                    Key dst)
+{
+  if (!k)
+    throw std::invalid_argument("generic_band_search: no bands");
+
+  generic_band_result<Permanent> result;
+  auto bands = split_bands(r, k, width);
+
+  result.m_initials.reserve(bands.size());
+  result.m_Ps.reserve(bands.size());
+
+  for(const auto &b: bands)
+    {
+      result.m_initials.push_back(initial(b));
+      result.m_Ps.emplace_back(count);
+    }
+
+  // The exceptions the searches threw, one per band.
+  std::vector<std::exception_ptr> errors(bands.size());
+
+  {
+    std::vector<std::jthread> threads;
+
+    for(std::size_t i = 0; i < bands.size(); ++i)
+      threads.emplace_back([&, i]
+      {
+        try
+          {
+            Tentative T(count);
+
+            // We only need the search to finish, since the target
+            // labels stay in the permanent labels.
+            for([[maybe_unused]] const auto &l:
+                  generic_search(result.m_Ps[i], T, f,
+                                 result.m_initials[i], dst))
+              ;
+          }
+        catch (...)
+          {
+            errors[i] = std::current_exception();
+          }
+      });
+  }
+
+  for(const auto &e: errors)
+    if (e)
+      std::rethrow_exception(e);
+
+  // The target labels of all bands.
+  for(std::size_t i = 0; i < bands.size(); ++i)
+    for(const auto &l: result.m_Ps[i][dst])
+      result.m_labels.emplace_back(i, &l);
+
+  // We sort them with <, so that a label can be worse than or equal
+  // to the labels that come before it only.
+  std::ranges::sort(result.m_labels, [](const auto &a, const auto &b)
+  {
+    return *a.second < *b.second;
+  });
+
+  // The labels in [m_labels.begin(), e) are boe-incomparable.
+  auto e = result.m_labels.begin();
+  for(auto i = result.m_labels.begin(); i != result.m_labels.end(); ++i)
+    {
+      bool dominated = false;
+
+      for(auto j = result.m_labels.begin(); j != e; ++j)
+        if (boe(*j->second, *i->second))
+          {
+            dominated = true;
+            break;
+          }
+
+      if (!dominated)
+        *e++ = *i;
+    }
+
+  result.m_labels.erase(e, result.m_labels.end());
+
+  return result;
+}
+
+#endif // GENERIC_BAND_SEARCH_HPP
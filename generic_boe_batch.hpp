@@ -0,0 +1,512 @@
+#ifndef GENERIC_BOE_BATCH_HPP
+#define GENERIC_BOE_BATCH_HPP
+
+#include "generic_label.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+// The batched boe: a label j is compared with a batch of at most 64
+// labels at once, and the results are returned as bit masks, where
+// bit i is for label i of the batch.
+struct boe_masks
+{
+  // The labels better than or equal to j (for has_better_or_equal).
+  std::uint64_t m_boe = 0;
+  // The labels worse than or equal to j (for purging).
+  std::uint64_t m_woe = 0;
+};
+
+// Set it to false for a label type, so that its labels are compared
+// with boe one by one, e.g., to measure what the kernels give.
+template <typename Label>
+inline constexpr bool boe_kernels_enabled = true;
+
+// The labels whose boe looks at the weight and the resources only, and
+// whose weights are unsigned and fit in 32 bits.  Not the labels whose
+// boe looks at more, e.g., at the hops of generic_hop_label.
+template <typename Label>
+concept boe_plain = boe_kernels_enabled<Label> &&
+  std::unsigned_integral<std::remove_cvref_t<
+    decltype(get_weight(std::declval<const Label &>()))>> &&
+  sizeof(get_weight(std::declval<const Label &>())) <= 4 &&
+  !requires(const Label &l) {get_hops(l);};
+
+// The labels of contiguous resources (CU) whose units fit in 32 bits:
+// the kernels compare them exactly.
+template <typename Label>
+concept cu_batchable = boe_plain<Label> && requires(const Label &l)
+{
+  {get_resources(l).min()} -> std::convertible_to<std::uint32_t>;
+  {get_resources(l).max()} -> std::convertible_to<std::uint32_t>;
+};
+
+// The labels of resources that are a set of contiguous resources
+// (SU).  The kernels compare the weights, the spans of the resources,
+// and the bitmaps of the resources folded to 64 bits: resources
+// include others only if their span and bitmap include the span and
+// bitmap of the others, and so the kernels find the candidates, which
+// we then compare with boe.
+template <typename Label>
+concept su_batchable = boe_plain<Label> && !cu_batchable<Label> &&
+  requires(const Label &l)
+{
+  {std::ranges::begin(get_resources(l))->min()} ->
+    std::convertible_to<std::uint32_t>;
+  {std::ranges::begin(get_resources(l))->max()} ->
+    std::convertible_to<std::uint32_t>;
+};
+
+// The labels the containers keep columns for.
+template <typename Label>
+concept boe_columnar = cu_batchable<Label> || su_batchable<Label>;
+
+// The number of units a bit of the folded bitmap stands for.  Folding
+// the units one to a bit would set all bits for the resources of 64
+// units or more, and the bitmaps would tell nothing.
+inline constexpr std::uint32_t boe_unit = 4;
+
+// The bitmap of the units of resources r folded to 64 bits: unit u is
+// bit u / boe_unit % 64.
+template <typename Resources>
+std::uint64_t
+boe_fold(const Resources &r)
+{
+  std::uint64_t m = 0;
+
+  for(const auto &cu: r)
+    if (cu.min() < cu.max())
+      {
+        auto a = cu.min() / boe_unit, n = (cu.max() - 1) / boe_unit - a + 1;
+        if (n >= 64)
+          return ~std::uint64_t(0);
+        m |= std::rotl((std::uint64_t(1) << n) - 1, a % 64);
+      }
+
+  return m;
+}
+
+// The number of labels of a group in the columns, which is the
+// number of 32-bit lanes of AVX-512.
+inline constexpr std::size_t boe_group = 16;
+
+// The number of fields of a label in the columns: the weight, the min
+// and the max of the resources, and for SU the low and high halves of
+// the folded bitmap.  For SU, the min and the max are of the span of
+// the resources.
+template <typename Label>
+inline constexpr std::size_t boe_fields = su_batchable<Label> ? 5 : 3;
+
+// The offset of field f of label i in the columns of F fields.
+template <std::size_t F>
+constexpr std::size_t
+boe_offset(std::size_t i, std::size_t f)
+{
+  return i / boe_group * F * boe_group + f * boe_group + i % boe_group;
+}
+
+// Field f of label i in the columns that start at g, of F fields.
+template <std::size_t F>
+const std::uint32_t *
+boe_lanes(const std::uint32_t *g, std::size_t i, std::size_t f)
+{
+  return g + boe_offset<F>(i, f);
+}
+
+// The fields of the labels laid out for the kernels, in the order the
+// labels are pushed.  The labels are in groups of boe_group: a group
+// has the weights of its labels, then their mins, and so on.  The
+// lanes past the size hold garbage, but the whole group is allocated,
+// so that the kernels can load whole vectors.
+template <typename Label>
+struct boe_columns
+{
+  // The number of fields.
+  static constexpr std::size_t F = boe_fields<Label>;
+
+  std::vector<std::uint32_t> m_c;
+  std::size_t m_size = 0;
+
+  std::size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  const std::uint32_t *
+  data() const
+  {
+    return m_c.data();
+  }
+
+  void
+  push_back(const Label &l)
+  {
+    if (m_size % boe_group == 0)
+      m_c.resize(m_c.size() + F * boe_group);
+    set(m_size++, l);
+  }
+
+  void
+  pop_back()
+  {
+    assert(m_size);
+    if (--m_size % boe_group == 0)
+      m_c.resize(m_c.size() - F * boe_group);
+  }
+
+  void
+  clear()
+  {
+    m_c.clear();
+    m_size = 0;
+  }
+
+  // Sets the fields of label i to those of label l.
+  void
+  set(std::size_t i, const Label &l)
+  {
+    assert(i < m_size);
+    auto *g = m_c.data() + boe_offset<F>(i, 0);
+    auto f = fields(l);
+    for(std::size_t k = 0; k < F; ++k)
+      g[k * boe_group] = f[k];
+  }
+
+  // Moves the fields of label i to label k.
+  void
+  move(std::size_t i, std::size_t k)
+  {
+    const auto *s = m_c.data() + boe_offset<F>(i, 0);
+    auto *d = m_c.data() + boe_offset<F>(k, 0);
+    for(std::size_t f = 0; f < F; ++f)
+      d[f * boe_group] = s[f * boe_group];
+  }
+
+  static std::array<std::uint32_t, F>
+  fields(const Label &l)
+  {
+    const auto &r = get_resources(l);
+
+    if constexpr (cu_batchable<Label>)
+      return {get_weight(l), r.min(), r.max()};
+    else
+      {
+        std::uint32_t min = -1, max = 0;
+        for(const auto &cu: r)
+          {
+            min = std::min<std::uint32_t>(min, cu.min());
+            max = std::max<std::uint32_t>(max, cu.max());
+          }
+
+        auto m = boe_fold(r);
+        return {get_weight(l), min, max, std::uint32_t(m),
+                std::uint32_t(m >> 32)};
+      }
+  }
+};
+
+// The kernel compares labels [0, n) of the columns that start at g,
+// where n <= 64, with the label of fields j.
+using boe_kernel = boe_masks (*)(const std::uint32_t *g, std::size_t n,
+                                 const std::uint32_t *j);
+
+// The mask of the first n bits.
+inline std::uint64_t
+boe_first_bits(std::size_t n)
+{
+  return n == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << n) - 1;
+}
+
+inline boe_masks
+boe_kernel_scalar(const std::uint32_t *g, std::size_t n,
+                  const std::uint32_t *j)
+{
+  boe_masks m;
+
+  // We use & instead of &&, so that there are no branches.
+  for(std::size_t i = 0; i < n; ++i)
+    {
+      auto bw = *boe_lanes<3>(g, i, 0);
+      auto bmin = *boe_lanes<3>(g, i, 1);
+      auto bmax = *boe_lanes<3>(g, i, 2);
+      std::uint64_t ib = (bw <= j[0]) & (bmin <= j[1]) & (bmax >= j[2]);
+      std::uint64_t jb = (j[0] <= bw) & (j[1] <= bmin) & (j[2] >= bmax);
+      m.m_boe |= ib << i;
+      m.m_woe |= jb << i;
+    }
+
+  return m;
+}
+
+// The SU kernels find the candidates: label i can be better than or
+// equal to j if its weight is not larger, and its span and bitmap
+// include the span and bitmap of j.
+inline boe_masks
+su_kernel_scalar(const std::uint32_t *g, std::size_t n,
+                 const std::uint32_t *j)
+{
+  boe_masks m;
+
+  for(std::size_t i = 0; i < n; ++i)
+    {
+      auto bw = *boe_lanes<5>(g, i, 0);
+      auto bmin = *boe_lanes<5>(g, i, 1);
+      auto bmax = *boe_lanes<5>(g, i, 2);
+      auto blo = *boe_lanes<5>(g, i, 3);
+      auto bhi = *boe_lanes<5>(g, i, 4);
+      std::uint64_t ib = (bw <= j[0]) & (bmin <= j[1]) & (bmax >= j[2]) &
+        !(j[3] & ~blo) & !(j[4] & ~bhi);
+      std::uint64_t jb = (j[0] <= bw) & (j[1] <= bmin) & (j[2] >= bmax) &
+        !(blo & ~j[3]) & !(bhi & ~j[4]);
+      m.m_boe |= ib << i;
+      m.m_woe |= jb << i;
+    }
+
+  return m;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+// AVX2 has no unsigned comparisons, so we say a <= b when min(a, b)
+// == a.  The CU kernel is the SU kernel without the bitmaps.
+template <bool SU>
+__attribute__((target("avx2"))) inline boe_masks
+boe_kernel_avx2_impl(const std::uint32_t *g, std::size_t n,
+                     const std::uint32_t *j)
+{
+  constexpr std::size_t F = SU ? 5 : 3;
+  boe_masks m;
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i vw = _mm256_set1_epi32(j[0]);
+  const __m256i vmin = _mm256_set1_epi32(j[1]);
+  const __m256i vmax = _mm256_set1_epi32(j[2]);
+
+  for(std::size_t i = 0; i < n; i += 8)
+    {
+      auto bw = _mm256_loadu_si256((const __m256i *)boe_lanes<F>(g, i, 0));
+      auto bmin = _mm256_loadu_si256((const __m256i *)
+                                     boe_lanes<F>(g, i, 1));
+      auto bmax = _mm256_loadu_si256((const __m256i *)
+                                     boe_lanes<F>(g, i, 2));
+
+      auto mw = _mm256_min_epu32(bw, vw);
+      auto mmin = _mm256_min_epu32(bmin, vmin);
+      auto mmax = _mm256_max_epu32(bmax, vmax);
+
+      // Label i is better than or equal to j.
+      auto ib = _mm256_and_si256(_mm256_cmpeq_epi32(mw, bw),
+        _mm256_and_si256(_mm256_cmpeq_epi32(mmin, bmin),
+                         _mm256_cmpeq_epi32(mmax, bmax)));
+      // Label j is better than or equal to i.
+      auto jb = _mm256_and_si256(_mm256_cmpeq_epi32(mw, vw),
+        _mm256_and_si256(_mm256_cmpeq_epi32(mmin, vmin),
+                         _mm256_cmpeq_epi32(mmax, vmax)));
+
+      if constexpr (SU)
+        {
+          const __m256i vlo = _mm256_set1_epi32(j[3]);
+          const __m256i vhi = _mm256_set1_epi32(j[4]);
+          auto blo = _mm256_loadu_si256((const __m256i *)
+                                        boe_lanes<F>(g, i, 3));
+          auto bhi = _mm256_loadu_si256((const __m256i *)
+                                        boe_lanes<F>(g, i, 4));
+
+          // The bits of j not in i, and of i not in j.
+          auto jni = _mm256_or_si256(_mm256_andnot_si256(blo, vlo),
+                                     _mm256_andnot_si256(bhi, vhi));
+          auto inj = _mm256_or_si256(_mm256_andnot_si256(vlo, blo),
+                                     _mm256_andnot_si256(vhi, bhi));
+
+          ib = _mm256_and_si256(ib, _mm256_cmpeq_epi32(jni, zero));
+          jb = _mm256_and_si256(jb, _mm256_cmpeq_epi32(inj, zero));
+        }
+
+      m.m_boe |= std::uint64_t(unsigned(_mm256_movemask_ps
+                                        (_mm256_castsi256_ps(ib)))) << i;
+      m.m_woe |= std::uint64_t(unsigned(_mm256_movemask_ps
+                                        (_mm256_castsi256_ps(jb)))) << i;
+    }
+
+  m.m_boe &= boe_first_bits(n);
+  m.m_woe &= boe_first_bits(n);
+
+  return m;
+}
+
+inline boe_masks
+boe_kernel_avx2(const std::uint32_t *g, std::size_t n,
+                const std::uint32_t *j)
+{
+  return boe_kernel_avx2_impl<false>(g, n, j);
+}
+
+inline boe_masks
+su_kernel_avx2(const std::uint32_t *g, std::size_t n,
+               const std::uint32_t *j)
+{
+  return boe_kernel_avx2_impl<true>(g, n, j);
+}
+
+template <bool SU>
+__attribute__((target("avx512f"))) inline boe_masks
+boe_kernel_avx512_impl(const std::uint32_t *g, std::size_t n,
+                       const std::uint32_t *j)
+{
+  constexpr std::size_t F = SU ? 5 : 3;
+  boe_masks m;
+
+  const __m512i vw = _mm512_set1_epi32(j[0]);
+  const __m512i vmin = _mm512_set1_epi32(j[1]);
+  const __m512i vmax = _mm512_set1_epi32(j[2]);
+
+  for(std::size_t i = 0; i < n; i += 16)
+    {
+      auto bw = _mm512_loadu_si512(boe_lanes<F>(g, i, 0));
+      auto bmin = _mm512_loadu_si512(boe_lanes<F>(g, i, 1));
+      auto bmax = _mm512_loadu_si512(boe_lanes<F>(g, i, 2));
+
+      // Label i is better than or equal to j.
+      __mmask16 ib = _mm512_cmple_epu32_mask(bw, vw) &
+        _mm512_cmple_epu32_mask(bmin, vmin) &
+        _mm512_cmpge_epu32_mask(bmax, vmax);
+      // Label j is better than or equal to i.
+      __mmask16 jb = _mm512_cmpge_epu32_mask(bw, vw) &
+        _mm512_cmpge_epu32_mask(bmin, vmin) &
+        _mm512_cmple_epu32_mask(bmax, vmax);
+
+      if constexpr (SU)
+        {
+          const __m512i vlo = _mm512_set1_epi32(j[3]);
+          const __m512i vhi = _mm512_set1_epi32(j[4]);
+          const __m512i nvlo = _mm512_set1_epi32(~j[3]);
+          const __m512i nvhi = _mm512_set1_epi32(~j[4]);
+          const __m512i ones = _mm512_set1_epi32(-1);
+          auto blo = _mm512_loadu_si512(boe_lanes<F>(g, i, 3));
+          auto bhi = _mm512_loadu_si512(boe_lanes<F>(g, i, 4));
+
+          // No bits of j are not in i, and no bits of i are not in j.
+          ib &= _mm512_testn_epi32_mask(vlo, _mm512_xor_si512(blo, ones)) &
+            _mm512_testn_epi32_mask(vhi, _mm512_xor_si512(bhi, ones));
+          jb &= _mm512_testn_epi32_mask(blo, nvlo) &
+            _mm512_testn_epi32_mask(bhi, nvhi);
+        }
+
+      m.m_boe |= std::uint64_t(ib) << i;
+      m.m_woe |= std::uint64_t(jb) << i;
+    }
+
+  m.m_boe &= boe_first_bits(n);
+  m.m_woe &= boe_first_bits(n);
+
+  return m;
+}
+
+inline boe_masks
+boe_kernel_avx512(const std::uint32_t *g, std::size_t n,
+                  const std::uint32_t *j)
+{
+  return boe_kernel_avx512_impl<false>(g, n, j);
+}
+
+inline boe_masks
+su_kernel_avx512(const std::uint32_t *g, std::size_t n,
+                 const std::uint32_t *j)
+{
+  return boe_kernel_avx512_impl<true>(g, n, j);
+}
+
+#endif
+
+// Selects the best kernel for the CPU we run on: for CU or for SU.
+inline boe_kernel
+select_boe_kernel(bool su)
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+  if (__builtin_cpu_supports("avx512f"))
+    return su ? su_kernel_avx512 : boe_kernel_avx512;
+  if (__builtin_cpu_supports("avx2"))
+    return su ? su_kernel_avx2 : boe_kernel_avx2;
+#endif
+  return su ? su_kernel_scalar : boe_kernel_scalar;
+}
+
+// The kernel for the labels, selected once.
+template <typename Label>
+boe_kernel
+get_boe_kernel()
+{
+  static const boe_kernel k = select_boe_kernel(su_batchable<Label>);
+  return k;
+}
+
+// Compares label j with labels [first, first + n) of columns c, where
+// first is a multiple of boe_group, and n <= 64.  The SU kernels give
+// the candidates only, and so we compare them with boe: function at
+// returns label i of the columns.
+template <typename Label, typename At>
+boe_masks
+boe_batch(const boe_columns<Label> &c, std::size_t first, std::size_t n,
+          const Label &j, At at)
+{
+  assert(first % boe_group == 0 && n <= 64 && first + n <= c.size());
+
+  auto f = boe_columns<Label>::fields(j);
+  auto m = get_boe_kernel<Label>()(boe_lanes<boe_fields<Label>>
+                                   (c.data(), first, 0), n, f.data());
+
+  if constexpr (su_batchable<Label>)
+    {
+      for(auto r = m.m_boe; r; r &= r - 1)
+        if (!boe(at(first + std::countr_zero(r)), j))
+          m.m_boe &= ~(r & -r);
+
+      for(auto r = m.m_woe; r; r &= r - 1)
+        if (!boe(j, at(first + std::countr_zero(r))))
+          m.m_woe &= ~(r & -r);
+    }
+
+  return m;
+}
+
+// The fewest labels that boe_any compares with the kernels.  For
+// fewer labels, the kernels cost more than we gain.
+inline constexpr std::size_t boe_any_min = 8;
+
+// Is any label of [0, n) of columns c better than or equal to label j?
+// For n < boe_any_min, the columns are not read, and can be empty.
+template <typename Label, typename At>
+bool
+boe_any(const boe_columns<Label> &c, std::size_t n, const Label &j, At at)
+{
+  if (n < boe_any_min)
+    {
+      for(std::size_t i = 0; i < n; ++i)
+        if (boe(at(i), j))
+          return true;
+
+      return false;
+    }
+
+  for(std::size_t i = 0; i < n; i += 64)
+    if (boe_batch(c, i, std::min<std::size_t>(64, n - i), j, at).m_boe)
+      return true;
+
+  return false;
+}
+
+#endif // GENERIC_BOE_BATCH_HPP
@@ -0,0 +1,141 @@
+#ifndef GENERIC_BOUNDS_HPP
+#define GENERIC_BOUNDS_HPP
+
+#include "generic_label.hpp"
+
+#include <compare>
+#include <iostream>
+#include <limits>
+#include <ranges>
+#include <utility>
+
+// The bounds of the paths: the largest weight and the largest number
+// of hops (edges) of a path.  A candidate label past a bound is
+// dropped when it is created, and so the search does not go on with
+// the labels of the paths that we would not take anyway.
+//
+// The weights do not decrease along a path, and so a label over the
+// largest weight cannot lead to a label under it, and the labels need
+// not change.  The hops do not decrease either, but a label can be
+// better than or equal to another, and yet have more hops, and then
+// it could reach the hop limit first and leave us with nothing.  So
+// for the hop limit the label has to count its hops, and a label is
+// better than or equal to another only if it has no more hops: use
+// generic_hop_label.
+
+// The label has weight c, resources r, and the number of hops.
+template <typename Weight, typename Resources>
+struct generic_hop_label: generic_label<Weight, Resources>
+{
+  using base_type = generic_label<Weight, Resources>;
+
+  unsigned m_hops;
+
+  generic_hop_label(Weight w, const Resources &r, unsigned hops):
+    base_type(w, r), m_hops(hops)
+  {
+  }
+
+  generic_hop_label(std::pair<Weight, Resources> &&p, unsigned hops):
+    base_type(std::move(p)), m_hops(hops)
+  {
+  }
+
+  bool operator == (const generic_hop_label &) const = default;
+
+  // The labels of equal weights and resources are sorted by hops, so
+  // that a label better than or equal to another is not greater.
+  std::strong_ordering
+  operator <=> (const generic_hop_label &j) const
+  {
+    if (auto c = static_cast<const base_type &>(*this) <=>
+        static_cast<const base_type &>(j); c != 0)
+      return c;
+
+    return m_hops <=> j.m_hops;
+  }
+};
+
+template <typename Weight, typename Resources>
+unsigned
+get_hops(const generic_hop_label<Weight, Resources> &l)
+{
+  return l.m_hops;
+}
+
+// The "better or equal" function: no more hops too.
+template <typename Weight, typename Resources>
+bool
+boe(const generic_hop_label<Weight, Resources> &i,
+    const generic_hop_label<Weight, Resources> &j)
+{
+  using base_type = generic_label<Weight, Resources>;
+
+  return get_hops(i) <= get_hops(j) &&
+    boe(static_cast<const base_type &>(i),
+        static_cast<const base_type &>(j));
+}
+
+template <typename Weight, typename Resources>
+std::ostream &
+operator<<(std::ostream &out,
+           const generic_hop_label<Weight, Resources> &l)
+{
+  out << "label(weight = " << get_weight(l)
+      << ", resources = " << get_resources(l)
+      << ", hops = " << get_hops(l) << ")";
+
+  return out;
+}
+
+// The bounds.  By default there are none.  A weight is within the
+// bound if it is better than or equal to it (weight_boe), and so every
+// criterion of a weight_vector has its own bound.
+template <typename Weight>
+struct search_bounds
+{
+  Weight m_max_weight = std::numeric_limits<Weight>::max();
+  unsigned m_max_hops = std::numeric_limits<unsigned>::max();
+
+  // Is label l within the bounds?  The hops are looked at only if
+  // the label counts them.
+  template <typename Label>
+  bool
+  admits(const Label &l) const
+  {
+    if (!weight_boe(get_weight(l), m_max_weight))
+      return false;
+
+    if constexpr (requires {get_hops(l);})
+      return get_hops(l) <= m_max_hops;
+    else
+      return true;
+  }
+};
+
+// The functor that drops the candidate labels of functor f that are
+// not within the bounds.  Use it in place of f in the search, and in
+// generic_path_range.  The candidates are filtered as they are
+// iterated over, and so no range is copied.
+template <typename Functor, typename Weight>
+struct bounded_functor
+{
+  Functor m_f;
+  search_bounds<Weight> m_b;
+
+  template <typename Label, typename Edge>
+  auto
+  operator()(const Label &l, const Edge &e) const
+  {
+    return m_f(l, e) | std::views::filter([b = m_b](const auto &c)
+    {
+      return b.admits(c);
+    });
+  }
+};
+
+template <typename Functor, typename Weight>
+bounded_functor(Functor, search_bounds<Weight>) ->
+  bounded_functor<Functor, Weight>;
+
+#endif // GENERIC_BOUNDS_HPP
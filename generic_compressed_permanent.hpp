@@ -0,0 +1,354 @@
+#ifndef GENERIC_COMPRESSED_PERMANENT_HPP
+#define GENERIC_COMPRESSED_PERMANENT_HPP
+
+#include "generic_label.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// The compressed permanent labels: a read-only copy of the permanent
+// labels of a finished search (e.g., of generic_permanent) that takes
+// a few bytes per label.
+//
+// The labels of a key are sorted with <, and so their weights do not
+// decrease.  We store the fields of a label as the differences from
+// the fields of the previous label, in the variable-length encoding of
+// 7 bits per byte, and so a label of small differences takes a few
+// bytes.  The labels of a key are split into blocks of BlockSize
+// labels, and the first label of a block is stored in full, so that a
+// block can be decoded without the blocks before it.
+//
+// The labels are decoded on demand: the labels of a key are a range
+// of labels decoded one by one, and so has_better_or_equal, and
+// generic_path_range (which then holds the labels it decodes) work
+// as they do for generic_permanent.
+//
+// The codec turns a label into the compressed fields, and the fields
+// and the key back into a label.  The weights have to be unsigned
+// integers.  The resources are contiguous: [min, max).  The edge is
+// any number that the codec can turn back into the edge, e.g., the
+// key of the edge.
+
+// The fields of a label that we store.
+struct compressed_fields
+{
+  std::uint64_t m_weight;
+  std::uint64_t m_min;
+  std::uint64_t m_max;
+  std::uint64_t m_edge;
+};
+
+template <typename Codec, typename Label>
+concept compressed_codec = requires(const Codec &c, const Label &l,
+                                    const compressed_fields &f)
+{
+  {c.encode(l)} -> std::same_as<compressed_fields>;
+  {c.decode(f, std::size_t())} -> std::same_as<Label>;
+};
+
+// Appends number n in the variable-length encoding: 7 bits per byte,
+// the least significant first, and the highest bit tells whether more
+// bytes follow.
+inline void
+put_varint(std::vector<std::uint8_t> &b, std::uint64_t n)
+{
+  while(n >= 0x80)
+    {
+      b.push_back(n | 0x80);
+      n >>= 7;
+    }
+
+  b.push_back(n);
+}
+
+inline std::uint64_t
+get_varint(const std::uint8_t *&p)
+{
+  std::uint64_t n = 0;
+
+  for(unsigned s = 0; ; s += 7)
+    {
+      std::uint8_t c = *p++;
+      n |= std::uint64_t(c & 0x7f) << s;
+      if (!(c & 0x80))
+        return n;
+    }
+}
+
+// The difference that can be negative, mapped to an unsigned number,
+// so that the small differences of either sign are small numbers.
+inline std::uint64_t
+zigzag(std::uint64_t a, std::uint64_t b)
+{
+  auto d = static_cast<std::int64_t>(a - b);
+  return (static_cast<std::uint64_t>(d) << 1) ^
+    static_cast<std::uint64_t>(d >> 63);
+}
+
+inline std::uint64_t
+unzigzag(std::uint64_t b, std::uint64_t z)
+{
+  return b + ((z >> 1) ^ -(z & 1));
+}
+
+// Decodes the labels of a key, one by one, from the given label of
+// a block.
+template <typename Label, typename Codec, std::size_t BlockSize>
+struct compressed_label_iterator
+{
+  using iterator_concept = std::input_iterator_tag;
+  using value_type = Label;
+  using difference_type = std::ptrdiff_t;
+
+  const Codec *m_c = nullptr;
+  std::size_t m_key = 0;
+  // The bytes of the next label.
+  const std::uint8_t *m_p = nullptr;
+  // The number of the labels left, including the current label.
+  std::size_t m_left = 0;
+  // The number of the current label in its block.
+  std::size_t m_i = 0;
+  // The fields of the current label.
+  compressed_fields m_f{};
+
+  compressed_label_iterator() = default;
+
+  // Starts at the block of the given bytes.
+  compressed_label_iterator(const Codec &c, std::size_t key,
+                            const std::uint8_t *p, std::size_t left):
+    m_c(&c), m_key(key), m_p(p), m_left(left)
+  {
+    if (m_left)
+      decode();
+  }
+
+  // Decodes the next label.  The first label of a block is stored in
+  // full.
+  void
+  decode()
+  {
+    if (!m_i)
+      {
+        m_f.m_weight = get_varint(m_p);
+        m_f.m_min = get_varint(m_p);
+        m_f.m_max = m_f.m_min + get_varint(m_p);
+        m_f.m_edge = get_varint(m_p);
+      }
+    else
+      {
+        m_f.m_weight += get_varint(m_p);
+        m_f.m_min = unzigzag(m_f.m_min, get_varint(m_p));
+        m_f.m_max = m_f.m_min + get_varint(m_p);
+        m_f.m_edge = unzigzag(m_f.m_edge, get_varint(m_p));
+      }
+  }
+
+  Label
+  operator * () const
+  {
+    return m_c->decode(m_f, m_key);
+  }
+
+  const compressed_fields &
+  fields() const
+  {
+    return m_f;
+  }
+
+  compressed_label_iterator &
+  operator ++ ()
+  {
+    assert(m_left);
+
+    if (--m_left)
+      {
+        m_i = (m_i + 1) % BlockSize;
+        decode();
+      }
+
+    return *this;
+  }
+
+  void
+  operator ++ (int)
+  {
+    ++*this;
+  }
+
+  bool
+  operator == (std::default_sentinel_t) const
+  {
+    return !m_left;
+  }
+};
+
+// The labels of a key, decoded on demand.
+template <typename Iterator>
+struct compressed_labels
+{
+  Iterator m_begin;
+  std::size_t m_size;
+
+  Iterator
+  begin() const
+  {
+    return m_begin;
+  }
+
+  std::default_sentinel_t
+  end() const
+  {
+    return {};
+  }
+
+  std::size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return !m_size;
+  }
+};
+
+template <typename Label, typename Codec, std::size_t BlockSize = 16>
+  requires compressed_codec<Codec, Label>
+struct generic_compressed_permanent
+{
+  // The label type.
+  using label_type = Label;
+  // The size type.
+  using size_type = std::size_t;
+  // The iterator of the labels of a key.
+  using iterator = compressed_label_iterator<Label, Codec, BlockSize>;
+
+  Codec m_codec;
+  // The labels of all keys.
+  std::vector<std::uint8_t> m_bytes;
+  // The labels of key i are the labels [m_labels[i], m_labels[i + 1])
+  // of all keys.
+  std::vector<std::uint64_t> m_labels;
+  // The blocks of key i start at block m_blocks[i], and block b
+  // starts at byte m_offsets[b].
+  std::vector<std::uint64_t> m_blocks;
+  std::vector<std::uint64_t> m_offsets;
+
+  // Compresses the labels of P, e.g., of generic_permanent.
+  template <typename Permanent>
+  generic_compressed_permanent(const Permanent &P, Codec c = {}):
+    m_codec(std::move(c))
+  {
+    m_labels.reserve(P.size() + 1);
+    m_blocks.reserve(P.size() + 1);
+    m_labels.push_back(0);
+    m_blocks.push_back(0);
+
+    for(const auto &vd: P)
+      {
+        size_type i = 0;
+        compressed_fields p{};
+
+        for(const auto &l: vd)
+          {
+            auto f = m_codec.encode(l);
+            assert(f.m_min < f.m_max);
+
+            if (i % BlockSize == 0)
+              {
+                m_offsets.push_back(m_bytes.size());
+                put_varint(m_bytes, f.m_weight);
+                put_varint(m_bytes, f.m_min);
+                put_varint(m_bytes, f.m_max - f.m_min);
+                put_varint(m_bytes, f.m_edge);
+              }
+            else
+              {
+                // The labels are sorted with <.
+                assert(p.m_weight <= f.m_weight);
+                put_varint(m_bytes, f.m_weight - p.m_weight);
+                put_varint(m_bytes, zigzag(f.m_min, p.m_min));
+                put_varint(m_bytes, f.m_max - f.m_min);
+                put_varint(m_bytes, zigzag(f.m_edge, p.m_edge));
+              }
+
+            p = f;
+            ++i;
+          }
+
+        m_labels.push_back(m_labels.back() + i);
+        m_blocks.push_back(m_offsets.size());
+      }
+
+    m_bytes.shrink_to_fit();
+    m_offsets.shrink_to_fit();
+  }
+
+  size_type
+  size() const
+  {
+    return m_labels.size() - 1;
+  }
+
+  // The number of the labels of all keys.
+  size_type
+  label_count() const
+  {
+    return m_labels.back();
+  }
+
+  // The memory taken, without the codec.
+  size_type
+  bytes() const
+  {
+    return m_bytes.capacity() + (m_labels.capacity() +
+      m_blocks.capacity() + m_offsets.capacity()) * sizeof(std::uint64_t);
+  }
+
+  // The labels of key i.
+  compressed_labels<iterator>
+  operator[](size_type i) const
+  {
+    return from(i, 0);
+  }
+
+  // The labels of key i from label n on.  Only the block of label n
+  // is decoded up to it.
+  compressed_labels<iterator>
+  from(size_type i, size_type n) const
+  {
+    size_type count = m_labels[i + 1] - m_labels[i];
+    if (n >= count)
+      return {iterator(), 0};
+
+    auto b = m_blocks[i] + n / BlockSize;
+    iterator it(m_codec, i, m_bytes.data() + m_offsets[b],
+                count - n / BlockSize * BlockSize);
+    for(auto k = n % BlockSize; k; --k)
+      ++it;
+
+    return {it, count - n};
+  }
+};
+
+/**
+ * Is there in P a label that is better than or equal to label j?
+ */
+template <typename Label, typename Codec, std::size_t BlockSize>
+bool
+has_better_or_equal(const generic_compressed_permanent<Label, Codec,
+                    BlockSize> &P, const Label &j)
+{
+  // The labels are sorted with <, and boe stops at the first label
+  // that is greater than j.
+  return boe(P[get_key(j)], j);
+}
+
+#endif // GENERIC_COMPRESSED_PERMANENT_HPP
@@ -0,0 +1,584 @@
+#ifndef GENERIC_CONTRACTION_HPP
+#define GENERIC_CONTRACTION_HPP
+
+#include "generic_label.hpp"
+#include "generic_permanent.hpp"
+#include "generic_renumbering.hpp"
+#include "generic_tentative.hpp"
+#include "props.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+
+// The contraction hierarchy for the generic search, in the style of
+// the customizable contraction hierarchies: the preprocessing is done
+// in two phases.
+//
+// * The topology: the vertexes are contracted in the given order, and
+//   contracting a vertex connects its neighbours that come later.
+//   The edges of the resulting graph are the original edges and the
+//   shortcuts.  The topology depends on the graph only.
+//
+// * The customization: every directed edge of the hierarchy (an arc)
+//   gets the labels of the paths it stands for, i.e., the
+//   boe-incomparable labels, that we call the witnesses.  A single
+//   weight per shortcut is not enough, because a path of larger
+//   weight can have resources that a path of smaller weight does not.
+//
+// The arcs are customized bottom-up: the witnesses of arc a -> b are
+// the labels of the original edges from a to b, and the compositions
+// of the witnesses of arcs a -> v and v -> b for the vertexes v of
+// lower rank connected to both a and b (the lower triangles).  A
+// composition has the sum of weights and the intersection of
+// resources, as generic_label_creator produces.
+//
+// When the resources (or the weights) of some edges change, only the
+// arcs of these edges are customized again, and then the arcs whose
+// lower triangles have arcs whose witnesses changed.
+//
+// A query searches up from the source and up from the target with
+// the reversed arcs, with generic_permanent and generic_tentative,
+// and combines the labels at the vertexes reached by both searches.
+// The paths are unpacked to the keys of the original edges.
+//
+// A graph is a random-access range of vertexes, and a vertex and an
+// edge provide the graph interface.  The keys of the vertexes are
+// [0, size of the graph), and the edges have unique keys too.
+
+// The label of the up searches: we remember the arc and the witness
+// the label was produced with, and the permanent label it was
+// produced from, so that we can unpack the path.
+template <typename Weight, typename Resources>
+struct cch_label: generic_label<Weight, Resources>, key<std::size_t>
+{
+  using label_type = generic_label<Weight, Resources>;
+
+  // There is no arc nor predecessor for the initial label.
+  static constexpr std::size_t none =
+    std::numeric_limits<std::size_t>::max();
+
+  // The arc and the index of its witness.
+  std::size_t m_arc = none;
+  std::size_t m_witness = none;
+  // The predecessor: its key is the source of the arc, and here is
+  // its index in the permanent labels of the key.
+  std::size_t m_pred = none;
+
+  cch_label(const label_type &l, std::size_t k):
+    label_type(l), key<std::size_t>(k)
+  {
+  }
+};
+
+// The order of the contraction, in which the vertex of the smallest
+// degree is contracted next, and its neighbours are connected.  The
+// order is a renumbering: the new key of a vertex is its rank.
+template <typename Neighbours>
+vertex_renumbering
+min_degree_order(std::size_t count, Neighbours neighbours)
+{
+  std::vector<std::set<std::size_t>> adj(count);
+  for(std::size_t v = 0; v < count; ++v)
+    for(auto n: neighbours(v))
+      if (n != v)
+        {
+          adj[v].insert(n);
+          adj[n].insert(v);
+        }
+
+  // The vertexes not contracted yet, by degree.
+  std::set<std::pair<std::size_t, std::size_t>> q;
+  for(std::size_t v = 0; v < count; ++v)
+    q.emplace(adj[v].size(), v);
+
+  std::vector<std::size_t> order;
+  order.reserve(count);
+
+  while(!q.empty())
+    {
+      auto v = q.begin()->second;
+      q.erase(q.begin());
+      order.push_back(v);
+
+      // The neighbours lose v, and get connected.
+      std::vector<std::size_t> ns(adj[v].begin(), adj[v].end());
+      for(auto a: ns)
+        q.erase({adj[a].size(), a});
+      for(auto a: ns)
+        {
+          adj[a].erase(v);
+          for(auto b: ns)
+            if (a != b)
+              adj[a].insert(b);
+        }
+      for(auto a: ns)
+        q.emplace(adj[a].size(), a);
+    }
+
+  return vertex_renumbering(std::move(order));
+}
+
+template <typename Weight, typename Resources>
+struct generic_cch
+{
+  using label_type = generic_label<Weight, Resources>;
+  using query_label_type = cch_label<Weight, Resources>;
+  using size_type = std::size_t;
+
+  static constexpr size_type none = query_label_type::none;
+
+  // The label of a path an arc stands for.  The path is either an
+  // original edge, or the paths of two witnesses: of arc a -> v and
+  // of arc v -> b.
+  struct witness: label_type
+  {
+    // The key of the original edge, or none.
+    size_type m_edge = none;
+    // The arcs and the indexes of their witnesses.
+    size_type m_arc1 = none;
+    size_type m_index1 = none;
+    size_type m_arc2 = none;
+    size_type m_index2 = none;
+
+    witness(const label_type &l): label_type(l)
+    {
+    }
+  };
+
+  // The directed edge of the hierarchy.
+  struct arc
+  {
+    size_type m_source;
+    size_type m_target;
+    // The keys of the original edges from m_source to m_target.
+    std::vector<size_type> m_edges;
+    // The boe-incomparable labels of the paths of the arc.
+    std::vector<witness> m_witnesses;
+  };
+
+  // The lower triangle of an undirected edge {a, b}: the edges {v, a}
+  // and {v, b}, where v has a lower rank than a and b.
+  struct triangle
+  {
+    size_type m_va;
+    size_type m_vb;
+  };
+
+  // The order of the contraction.
+  vertex_renumbering m_order;
+
+  // The undirected edge k of the hierarchy is {x, y}, where x has a
+  // lower rank than y, and has two arcs: arc 2k is x -> y (up), and
+  // arc 2k + 1 is y -> x (down).
+  std::vector<arc> m_arcs;
+  // The undirected edges to the neighbours of higher rank.
+  std::vector<std::vector<size_type>> m_up;
+  // The lower triangles of the undirected edges.
+  std::vector<std::vector<triangle>> m_lower;
+  // The undirected edges whose lower triangles have the given edge.
+  std::vector<std::vector<size_type>> m_dependents;
+  // The undirected edges in the order of customization: by the rank
+  // of their lower vertex.
+  std::vector<size_type> m_customization;
+  // Is the undirected edge to be customized?
+  std::vector<bool> m_dirty;
+
+  // The arc and the label of an original edge, looked up with its key.
+  std::vector<size_type> m_edge_arc;
+  std::vector<label_type> m_edge_label;
+
+  template <typename Graph>
+  generic_cch(const Graph &g, vertex_renumbering order):
+    m_order(std::move(order)), m_up(g.size())
+  {
+    assert(m_order.size() == g.size());
+
+    // The undirected edges found so far, keyed by their ends of
+    // lower and higher rank.
+    std::map<std::pair<size_type, size_type>, size_type> ids;
+    // The neighbours, of any rank, in the hierarchy being built.
+    std::vector<std::set<size_type>> adj(g.size());
+
+    auto rank = [&](size_type v){return m_order.to_new(v);};
+
+    auto edge = [&](size_type a, size_type b)
+    {
+      if (rank(b) < rank(a))
+        std::swap(a, b);
+
+      auto [i, inserted] = ids.try_emplace({a, b}, ids.size());
+      if (inserted)
+        {
+          m_arcs.push_back({a, b, {}, {}});
+          m_arcs.push_back({b, a, {}, {}});
+          m_up[a].push_back(i->second);
+          adj[a].insert(b);
+          adj[b].insert(a);
+        }
+
+      return i->second;
+    };
+
+    // The original edges.
+    size_type count = 0;
+    for(const auto &v: g)
+      for(const auto &e: get_edges(v))
+        count = std::max<size_type>(count, get_key(e) + 1);
+
+    m_edge_arc.resize(count, none);
+    m_edge_label.resize(count, label_type(Weight(), Resources()));
+
+    for(const auto &v: g)
+      for(const auto &e: get_edges(v))
+        {
+          size_type s = get_key(v), t = get_key(get_target(e));
+          // The loops are of no use.
+          if (s == t)
+            continue;
+
+          auto k = edge(s, t);
+          // The up or the down arc.
+          auto a = 2 * k + (rank(s) > rank(t));
+          m_arcs[a].m_edges.push_back(get_key(e));
+          m_edge_arc[get_key(e)] = a;
+          m_edge_label[get_key(e)] = label_type(get_weight(e),
+                                                get_resources(e));
+        }
+
+    // The contraction: the neighbours of higher rank get connected.
+    for(size_type i = 0; i < g.size(); ++i)
+      {
+        auto v = m_order.to_old(i);
+        std::vector<size_type> ns;
+        for(auto n: adj[v])
+          if (rank(n) > i)
+            ns.push_back(n);
+
+        for(auto a: ns)
+          for(auto b: ns)
+            if (rank(a) < rank(b))
+              edge(a, b);
+      }
+
+    // The lower triangles.  The upper neighbours of every vertex are
+    // complete now.
+    m_lower.resize(ids.size());
+    m_dependents.resize(ids.size());
+
+    for(size_type v = 0; v < g.size(); ++v)
+      for(auto ka: m_up[v])
+        for(auto kb: m_up[v])
+          {
+            auto a = m_arcs[2 * ka].m_target;
+            auto b = m_arcs[2 * kb].m_target;
+            if (rank(a) < rank(b))
+              {
+                auto k = ids.at({a, b});
+                m_lower[k].push_back({ka, kb});
+                m_dependents[ka].push_back(k);
+                m_dependents[kb].push_back(k);
+              }
+          }
+
+    m_customization.resize(ids.size());
+    std::iota(m_customization.begin(), m_customization.end(), 0);
+    std::ranges::sort(m_customization, {}, [&](size_type k)
+    {
+      return rank(m_arcs[2 * k].m_source);
+    });
+
+    m_dirty.assign(ids.size(), true);
+    customize();
+  }
+
+  // The number of vertexes.
+  size_type
+  size() const
+  {
+    return m_up.size();
+  }
+
+  // Takes the new weight and resources of edge e.  Call customize to
+  // bring the witnesses up to date.
+  template <typename Edge>
+  void
+  update(const Edge &e)
+  {
+    auto a = m_edge_arc[get_key(e)];
+    // A loop.
+    if (a == none)
+      return;
+
+    m_edge_label[get_key(e)] = label_type(get_weight(e), get_resources(e));
+    m_dirty[a / 2] = true;
+  }
+
+  // Customizes the dirty edges, and then the edges that depend on the
+  // edges whose witnesses changed.  The indexes of the witnesses can
+  // change, and so the results of the earlier queries are invalid.
+  void
+  customize()
+  {
+    for(auto k: m_customization)
+      if (m_dirty[k])
+        {
+          m_dirty[k] = false;
+
+          bool changed = false;
+          for(auto a: {2 * k, 2 * k + 1})
+            {
+              auto ws = witnesses(a, k);
+              changed |= !std::ranges::equal(ws, m_arcs[a].m_witnesses,
+                                             std::equal_to<label_type>());
+              m_arcs[a].m_witnesses = std::move(ws);
+            }
+
+          if (changed)
+            for(auto d: m_dependents[k])
+              m_dirty[d] = true;
+        }
+  }
+
+  // The witnesses of arc a of undirected edge k.
+  std::vector<witness>
+  witnesses(size_type a, size_type k) const
+  {
+    std::vector<witness> ws;
+
+    for(auto e: m_arcs[a].m_edges)
+      {
+        witness w(m_edge_label[e]);
+        w.m_edge = e;
+        insert(ws, std::move(w));
+      }
+
+    // Arc a is x -> y, and for the lower triangle of v we compose the
+    // witnesses of arcs x -> v and v -> y.  If arc a is up, then x is
+    // the lower end of edge k, and arc x -> v is the down arc of edge
+    // {v, x} of the triangle, and arc v -> y is the up arc of edge {v,
+    // y}.  If arc a is down, the edges of the triangle swap places.
+    bool up = a % 2 == 0;
+    for(const auto &t: m_lower[k])
+      {
+        auto a1 = 2 * (up ? t.m_va : t.m_vb) + 1;
+        auto a2 = 2 * (up ? t.m_vb : t.m_va);
+
+        for(size_type i1 = 0; i1 < m_arcs[a1].m_witnesses.size(); ++i1)
+          for(size_type i2 = 0; i2 < m_arcs[a2].m_witnesses.size(); ++i2)
+            {
+              const auto &w1 = m_arcs[a1].m_witnesses[i1];
+              const auto &w2 = m_arcs[a2].m_witnesses[i2];
+              auto r = intersection(get_resources(w1), get_resources(w2));
+              if (r.empty())
+                continue;
+
+              witness w(label_type(get_weight(w1) + get_weight(w2),
+                                   std::move(r)));
+              w.m_arc1 = a1;
+              w.m_index1 = i1;
+              w.m_arc2 = a2;
+              w.m_index2 = i2;
+              insert(ws, std::move(w));
+            }
+      }
+
+    // We keep them sorted, so that we can tell whether they changed.
+    std::ranges::sort(ws, std::less<label_type>());
+
+    return ws;
+  }
+
+  // Inserts witness w into ws, unless a witness in ws is better than
+  // or equal to w, and drops the witnesses worse than or equal to w.
+  static void
+  insert(std::vector<witness> &ws, witness &&w)
+  {
+    for(const auto &i: ws)
+      if (boe(i, w))
+        return;
+
+    std::erase_if(ws, [&](const auto &i){return boe(w, i);});
+    ws.push_back(std::move(w));
+  }
+
+  // The original edges of witness i of arc a are appended to path.
+  void
+  unpack(size_type a, size_type i, std::vector<size_type> &path) const
+  {
+    const auto &w = m_arcs[a].m_witnesses[i];
+
+    if (w.m_edge != none)
+      path.push_back(w.m_edge);
+    else
+      {
+        unpack(w.m_arc1, w.m_index1, path);
+        unpack(w.m_arc2, w.m_index2, path);
+      }
+  }
+};
+
+// The result of a query of generic_cch.
+template <typename Weight, typename Resources>
+struct generic_cch_result
+{
+  using cch_type = generic_cch<Weight, Resources>;
+  using label_type = typename cch_type::label_type;
+  using query_label_type = typename cch_type::query_label_type;
+  using permanent_type = generic_permanent<query_label_type>;
+  using size_type = std::size_t;
+
+  // A label of a path: the vertex where the searches met, and the
+  // indexes of their labels there.
+  struct path_label: label_type
+  {
+    size_type m_meet;
+    size_type m_forward;
+    size_type m_backward;
+
+    path_label(const label_type &l, size_type meet, size_type f,
+               size_type b):
+      label_type(l), m_meet(meet), m_forward(f), m_backward(b)
+    {
+    }
+  };
+
+  // The labels of the search up from the source, and of the search up
+  // from the target with the reversed arcs.
+  permanent_type m_forward;
+  permanent_type m_backward;
+  // The boe-incomparable labels of the paths, sorted with <.
+  std::vector<path_label> m_labels;
+
+  generic_cch_result(size_type count): m_forward(count), m_backward(count)
+  {
+  }
+
+  // The keys of the original edges of the path of label l.
+  std::vector<size_type>
+  unpack(const cch_type &cch, const path_label &l) const
+  {
+    std::vector<size_type> path;
+
+    // The arcs of the search up from the source, from the meeting
+    // vertex back to the source.
+    std::vector<std::pair<size_type, size_type>> up;
+    for(const auto *p = &m_forward[l.m_meet][l.m_forward];
+        p->m_arc != cch_type::none;
+        p = &m_forward[cch.m_arcs[p->m_arc].m_source][p->m_pred])
+      up.emplace_back(p->m_arc, p->m_witness);
+
+    for(auto i = up.rbegin(); i != up.rend(); ++i)
+      cch.unpack(i->first, i->second, path);
+
+    // The reversed arcs of the search from the target, from the
+    // meeting vertex to the target.
+    for(const auto *p = &m_backward[l.m_meet][l.m_backward];
+        p->m_arc != cch_type::none;
+        p = &m_backward[cch.m_arcs[p->m_arc].m_target][p->m_pred])
+      cch.unpack(p->m_arc, p->m_witness, path);
+
+    return path;
+  }
+};
+
+// The search up from vertex src with the arcs that go up (forward),
+// or from vertex src with the arcs that go down to it (backward), of
+// the labels whose resources satisfy predicate fits.
+template <typename Weight, typename Resources, typename Fits>
+void
+cch_search(const generic_cch<Weight, Resources> &cch,
+           generic_permanent<cch_label<Weight, Resources>> &P,
+           std::size_t src, const Resources &r, bool forward, Fits fits)
+{
+  using label_type = cch_label<Weight, Resources>;
+
+  generic_tentative<label_type> T(cch.size());
+  T.push(label_type({Weight(), r}, src));
+
+  while(!T.empty())
+    {
+      const auto &l = P.push(T.pop());
+      auto v = get_key(l);
+      auto li = P[v].size() - 1;
+
+      for(auto k: cch.m_up[v])
+        {
+          // Forward, we follow arc v -> u, and backward arc u -> v.
+          auto a = 2 * k + !forward;
+          const auto &ws = cch.m_arcs[a].m_witnesses;
+          auto u = cch.m_arcs[2 * k].m_target;
+
+          for(std::size_t i = 0; i < ws.size(); ++i)
+            {
+              auto cr = intersection(get_resources(l),
+                                     get_resources(ws[i]));
+              if (cr.empty() || !fits(cr))
+                continue;
+
+              label_type c({get_weight(l) + get_weight(ws[i]),
+                            std::move(cr)}, u);
+              c.m_arc = a;
+              c.m_witness = i;
+              c.m_pred = li;
+
+              if (!has_better_or_equal(P, c) && !has_better_or_equal(T, c))
+                T.push(std::move(c));
+            }
+        }
+    }
+}
+
+// Finds the boe-incomparable labels of the paths from src to dst,
+// that start with resources r, and whose resources satisfy predicate
+// fits, e.g., are wide enough for a demand.
+template <typename Weight, typename Resources, typename Fits>
+auto
+cch_query(const generic_cch<Weight, Resources> &cch, std::size_t src,
+          std::size_t dst, const Resources &r, Fits fits)
+{
+  using result_type = generic_cch_result<Weight, Resources>;
+  using label_type = typename result_type::label_type;
+
+  result_type result(cch.size());
+  cch_search(cch, result.m_forward, src, r, true, fits);
+  cch_search(cch, result.m_backward, dst, r, false, fits);
+
+  // The paths: the labels of both searches combined at every vertex.
+  for(std::size_t v = 0; v < cch.size(); ++v)
+    for(std::size_t i = 0; i < result.m_forward[v].size(); ++i)
+      for(std::size_t j = 0; j < result.m_backward[v].size(); ++j)
+        {
+          const auto &f = result.m_forward[v][i];
+          const auto &b = result.m_backward[v][j];
+          auto cr = intersection(get_resources(f), get_resources(b));
+          if (cr.empty() || !fits(cr))
+            continue;
+
+          result.m_labels.emplace_back(label_type(get_weight(f) +
+                                                  get_weight(b),
+                                                  std::move(cr)),
+                                       v, i, j);
+        }
+
+  // We sort them with <, so that a label can be worse than or equal
+  // to the labels that come before it only.
+  std::ranges::sort(result.m_labels, std::less<label_type>());
+
+  std::vector<typename result_type::path_label> labels;
+  for(auto &l: result.m_labels)
+    if (std::ranges::none_of(labels, [&](const auto &i){return boe(i, l);}))
+      labels.push_back(std::move(l));
+  result.m_labels = std::move(labels);
+
+  return result;
+}
+
+#endif // GENERIC_CONTRACTION_HPP
@@ -0,0 +1,583 @@
+#ifndef GENERIC_DISJOINT_HPP
+#define GENERIC_DISJOINT_HPP
+
+#include "generic_label.hpp"
+#include "generic_label_correcting.hpp"
+#include "generic_label_creator.hpp"
+#include "generic_pareto.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "props.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The pairs of edge-disjoint paths, e.g., of a working path and its
+// protection path, where each path has its own contiguous resources
+// of the demand's width (the spectrum continuity holds for each path
+// on its own).
+//
+// We search as Bhandari does, with the labels:
+//
+// * First we find the working paths: the target labels of
+//   generic_search.
+//
+// * For every working path, we build the residual graph: the edges of
+//   the working path are reversed, and their weights negated.  The
+//   reversed edges do not limit the resources.
+//
+// * We search the residual graph with generic_label_correcting,
+//   because generic_pareto takes the labels in any order, and so it
+//   does not mind the negative weights.  A working path that is not
+//   the shortest one gives the residual graph negative cycles, which
+//   go back along the working path.  A label counts the reversed
+//   edges it went along, and a label is better than or equal to
+//   another only if it went along no more of them.  Going around a
+//   cycle, a label goes along more reversed edges, and so it cannot
+//   replace the label it came from.  A label goes along at most as
+//   many reversed edges as the working path has, and so the search is
+//   finite.
+//
+// * For every target label of the residual search, the edges of the
+//   working path that the label goes back along cancel out, and the
+//   edges that are left make up the two paths.  We take their
+//   resources along the edges.
+//
+// The pairs are compared by their weight (the sum of the weights of
+// the paths) and the resources of the paths, and we return the pairs
+// found that no other pair found is better than or equal to.  The
+// search is approximate: it does not enumerate the Pareto front of all
+// pairs.  The resources of the residual labels only tell the
+// resources of the paths roughly, since the paths swap their parts
+// where the edges cancel out, and we try a few working paths only.
+// So a pair of the front can be missing, and a returned pair can be
+// worse than or equal to a pair that is missing.  Every returned pair
+// is a pair of edge-disjoint paths whose resources fit the width, and
+// the pair of the smallest weight is found if the paths can use the
+// same resources (e.g., when no resources are in use).
+//
+// The resources are contiguous, as in split_bands.  The graph is a
+// random-access range of vertexes, where vertex i has key i.
+
+template <typename Edge>
+using disjoint_weight_t =
+  std::remove_cvref_t<decltype(get_weight(std::declval<const Edge &>()))>;
+
+template <typename Edge>
+using disjoint_resources_t =
+  std::remove_cvref_t<decltype(get_resources(std::declval<const Edge &>()))>;
+
+// The weights of the residual graph can be negative.
+template <typename Edge>
+using residual_weight_t = typename std::conditional_t
+  <std::is_unsigned_v<disjoint_weight_t<Edge>>,
+   std::make_signed<disjoint_weight_t<Edge>>,
+   std::type_identity<disjoint_weight_t<Edge>>>::type;
+
+template <typename Edge>
+struct residual_edge;
+
+// The residual edge that is not reversed.
+constexpr std::size_t residual_forward = -1;
+
+template <typename Edge>
+struct residual_vertex
+{
+  std::size_t m_key;
+  std::vector<residual_edge<Edge>> m_edges;
+
+  bool
+  operator == (const residual_vertex &v) const
+  {
+    return this == &v;
+  }
+};
+
+template <typename Edge>
+struct residual_edge: weight<residual_weight_t<Edge>>,
+                      resources<disjoint_resources_t<Edge>>
+{
+  const residual_vertex<Edge> *m_source;
+  const residual_vertex<Edge> *m_target;
+  // The edge of the graph, or nullptr for the initial loop edge.
+  const Edge *m_e;
+  // The number of the reversed edge in the working path, or
+  // residual_forward.
+  std::size_t m_back;
+
+  residual_edge(const residual_vertex<Edge> &s,
+                const residual_vertex<Edge> &t, residual_weight_t<Edge> w,
+                const disjoint_resources_t<Edge> &r, const Edge *e,
+                std::size_t back):
+    weight<residual_weight_t<Edge>>(w),
+    resources<disjoint_resources_t<Edge>>(r),
+    m_source(&s), m_target(&t), m_e(e), m_back(back)
+  {
+  }
+
+  bool
+  operator == (const residual_edge &e) const
+  {
+    return this == &e;
+  }
+};
+
+template <typename Edge>
+std::size_t
+get_key(const residual_vertex<Edge> &v)
+{
+  return v.m_key;
+}
+
+template <typename Edge>
+const residual_vertex<Edge> &
+get_source(const residual_edge<Edge> &e)
+{
+  return *e.m_source;
+}
+
+template <typename Edge>
+const residual_vertex<Edge> &
+get_target(const residual_edge<Edge> &e)
+{
+  return *e.m_target;
+}
+
+template <typename Edge>
+const auto &
+get_edges(const residual_vertex<Edge> &v)
+{
+  return v.m_edges;
+}
+
+// The residual graph: the vertexes must not move once the edges refer
+// to them, and so we create all of them in the constructor.
+template <typename Edge>
+struct residual_graph: std::vector<residual_vertex<Edge>>
+{
+  using base_type = std::vector<residual_vertex<Edge>>;
+
+  residual_graph(std::size_t count)
+  {
+    base_type::reserve(count);
+    for(std::size_t i = 0; i < count; ++i)
+      base_type::push_back({i, {}});
+  }
+};
+
+// The label of the residual graph.  The reversed edges do not take
+// part in <.
+template <typename Edge>
+struct residual_label: generic_label<residual_weight_t<Edge>,
+                                     disjoint_resources_t<Edge>>,
+                       key<std::size_t>
+{
+  using label_type = generic_label<residual_weight_t<Edge>,
+                                   disjoint_resources_t<Edge>>;
+
+  const residual_edge<Edge> *m_edge;
+  // The number of the reversed edges the label went along.
+  unsigned m_back;
+
+  residual_label(const label_type &l, const residual_edge<Edge> &e,
+                 unsigned back = 0):
+    label_type(l), key<std::size_t>(get_key(get_target(e))), m_edge(&e),
+    m_back(back)
+  {
+  }
+
+  bool operator == (const residual_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l) && m_back == l.m_back;
+  }
+
+  auto operator <=> (const residual_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+template <typename Edge>
+const residual_edge<Edge> &
+get_edge(const residual_label<Edge> &l)
+{
+  return *l.m_edge;
+}
+
+template <typename Edge>
+bool
+boe(const residual_label<Edge> &i, const residual_label<Edge> &j)
+{
+  using label_type = typename residual_label<Edge>::label_type;
+
+  return i.m_back <= j.m_back &&
+    boe(static_cast<const label_type &>(i),
+        static_cast<const label_type &>(j));
+}
+
+// The candidate labels of a relaxation: none or one.
+template <typename Edge>
+struct residual_candidates
+{
+  std::optional<residual_label<Edge>> m_l;
+
+  residual_label<Edge> *
+  begin()
+  {
+    return m_l ? &*m_l : nullptr;
+  }
+
+  residual_label<Edge> *
+  end()
+  {
+    return m_l ? &*m_l + 1 : nullptr;
+  }
+};
+
+// The candidate is discarded if its resources cannot fit the width,
+// or if it goes along more reversed edges than the limit.
+template <typename Edge>
+struct residual_functor
+{
+  unsigned m_width;
+  // The number of the edges of the working path.
+  unsigned m_limit;
+
+  residual_candidates<Edge>
+  operator()(const residual_label<Edge> &l,
+             const residual_edge<Edge> &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty() || r.max() - r.min() < m_width)
+      return {};
+
+    auto back = l.m_back + (e.m_back != residual_forward);
+    if (back > m_limit)
+      return {};
+
+    return {residual_label<Edge>({w, r}, e, back)};
+  }
+};
+
+// A path of a pair.
+template <typename Edge>
+struct disjoint_path
+{
+  disjoint_weight_t<Edge> m_weight;
+  // The resources along the edges.
+  disjoint_resources_t<Edge> m_resources;
+  // From the source to the target.
+  std::vector<const Edge *> m_edges;
+};
+
+// The pair: the lighter path goes first.
+template <typename Edge>
+struct disjoint_pair
+{
+  disjoint_weight_t<Edge> m_weight;
+  std::array<disjoint_path<Edge>, 2> m_paths;
+};
+
+// Is pair a better than or equal to pair b?  The paths of a pair have
+// no order.
+template <typename Edge>
+bool
+boe(const disjoint_pair<Edge> &a, const disjoint_pair<Edge> &b)
+{
+  const auto &[a0, a1] = a.m_paths;
+  const auto &[b0, b1] = b.m_paths;
+
+  return a.m_weight <= b.m_weight &&
+    ((includes(a0.m_resources, b0.m_resources) &&
+      includes(a1.m_resources, b1.m_resources)) ||
+     (includes(a0.m_resources, b1.m_resources) &&
+      includes(a1.m_resources, b0.m_resources)));
+}
+
+// The path of the given edges, if its resources (from r on) fit the
+// width.
+template <typename Edge>
+std::optional<disjoint_path<Edge>>
+make_disjoint_path(std::vector<const Edge *> es,
+                   const disjoint_resources_t<Edge> &r, unsigned width)
+{
+  disjoint_path<Edge> p{0, r, std::move(es)};
+
+  for(const auto *e: p.m_edges)
+    {
+      p.m_weight += get_weight(*e);
+      p.m_resources = intersection(p.m_resources, get_resources(*e));
+    }
+
+  if (p.m_resources.empty() ||
+      p.m_resources.max() - p.m_resources.min() < width)
+    return std::nullopt;
+
+  return p;
+}
+
+// Makes the pair of the working path w and the residual path s (both
+// from the source to the target).  The edges of w that s goes back
+// along cancel out, and we split the edges left into two paths from
+// the source: at every vertex we take any edge left, and we drop the
+// cycles.  Returns nothing if s goes twice along an edge, or if the
+// resources of a path do not fit the width.
+//
+// Vector at has an element for every vertex, all npos, and we leave
+// it so.
+template <typename Edge>
+std::optional<disjoint_pair<Edge>>
+make_disjoint_pair(const std::vector<const Edge *> &w,
+                   const std::vector<const residual_edge<Edge> *> &s,
+                   std::size_t src, std::size_t dst,
+                   const disjoint_resources_t<Edge> &r, unsigned width,
+                   std::vector<std::size_t> &at)
+{
+  constexpr auto npos = std::size_t(-1);
+
+  // The edges of the paths, and whether they were taken.
+  std::vector<std::pair<const Edge *, bool>> es;
+  for(const auto *e: w)
+    es.emplace_back(e, false);
+
+  for(const auto *re: s)
+    {
+      auto i = std::ranges::find_if(es, [re](const auto &x)
+      {
+        return x.first == re->m_e;
+      });
+      if (re->m_back != residual_forward)
+        {
+          if (i == es.end())
+            return std::nullopt;
+          es.erase(i);
+        }
+      else
+        {
+          if (i != es.end())
+            return std::nullopt;
+          es.emplace_back(re->m_e, false);
+        }
+    }
+
+  std::array<std::vector<const Edge *>, 2> ps;
+
+  for(auto &p: ps)
+    {
+      at[src] = 0;
+      for(std::size_t v = src; v != dst;)
+        {
+          auto i = std::ranges::find_if(es, [v](const auto &x)
+          {
+            return !x.second && get_key(get_source(*x.first)) == v;
+          });
+          // Cannot happen, since the edges meet the flow conservation.
+          if (i == es.end())
+            break;
+
+          i->second = true;
+          v = get_key(get_target(*i->first));
+
+          if (at[v] != npos)
+            {
+              // We drop the cycle back to v.
+              for(auto j = at[v]; j < p.size(); ++j)
+                at[get_key(get_target(*p[j]))] = npos;
+              p.resize(at[v]);
+            }
+          else
+            {
+              p.push_back(i->first);
+              at[v] = p.size();
+            }
+        }
+
+      at[src] = npos;
+      for(const auto *e: p)
+        at[get_key(get_target(*e))] = npos;
+    }
+
+  auto p0 = make_disjoint_path(std::move(ps[0]), r, width);
+  auto p1 = make_disjoint_path(std::move(ps[1]), r, width);
+  if (!p0 || !p1 || p0->m_edges.empty() || p1->m_edges.empty() ||
+      get_key(get_target(*p0->m_edges.back())) != dst ||
+      get_key(get_target(*p1->m_edges.back())) != dst)
+    return std::nullopt;
+
+  if (p1->m_weight < p0->m_weight)
+    std::swap(p0, p1);
+
+  auto weight = p0->m_weight + p1->m_weight;
+  return disjoint_pair<Edge>{weight, {std::move(*p0), std::move(*p1)}};
+}
+
+// The edges of the path of label l from the source to the target.
+// We go back as generic_path_range does, but the labels of the
+// residual graph often have equal weights, and then two labels of a
+// vertex can produce the same label, and we take either.
+//
+// We throw std::runtime_error if no label of P produced a label of
+// the path, or if the path goes back along more edges than P has
+// labels, i.e., the labels we take produce one another in a cycle.
+template <typename Permanent, typename Functor>
+auto
+residual_path(const Permanent &P, const Functor &f,
+              const typename Permanent::label_type &l,
+              const typename Permanent::label_type &initial)
+{
+  std::vector<std::remove_cvref_t<decltype(l.m_edge)>> es;
+
+  // A path without cycles has at most one edge per label.
+  std::size_t labels = 0;
+  for(std::size_t v = 0; v < P.size(); ++v)
+    labels += P[v].size();
+
+  for(const auto *c = &l; !(get_edge(*c) == get_edge(initial));)
+    {
+      const auto &e = get_edge(*c);
+      es.push_back(&e);
+
+      // The label that produced label c.
+      const decltype(c) p = c;
+      for(const auto &pl: P[get_key(get_source(e))])
+        for(const auto &cl: f(pl, e))
+          if (cl == *p)
+            c = &pl;
+
+      if (c == p)
+        throw std::runtime_error("residual_path: no preceding label");
+      if (es.size() > labels)
+        throw std::runtime_error("residual_path: cycle");
+    }
+
+  std::ranges::reverse(es);
+
+  return es;
+}
+
+// The pairs of edge-disjoint paths from vertex src to vertex dst of
+// graph g, for the demand of the given width in resources r, found as
+// described above: an approximation of the Pareto front.  The pairs
+// are sorted by weight.
+//
+// We try at most the given number of working paths (all if 0), in
+// the order of <, since every working path costs a search of the
+// residual graph.  The first working path is the one of Bhandari: the
+// lightest one.  The more working paths we try, the more pairs we
+// find, but most of them we find with the first one.
+template <typename Graph, typename Resources>
+auto
+generic_approx_disjoint_pairs(const Graph &g, std::size_t src,
+                              std::size_t dst, const Resources &r,
+                              unsigned width, std::size_t working = 1)
+{
+  using edge_type = std::remove_cvref_t
+    <std::ranges::range_reference_t<decltype(get_edges(g[0]))>>;
+  using label_type = residual_label<edge_type>;
+  using weight_type = residual_weight_t<edge_type>;
+
+  const auto n = g.size();
+  std::vector<disjoint_pair<edge_type>> result;
+  if (src == dst)
+    return result;
+
+  // The graph as it is, with the weights of the residual graphs.
+  residual_graph<edge_type> G(n);
+  for(std::size_t v = 0; v < n; ++v)
+    for(const auto &e: get_edges(g[v]))
+      G[v].m_edges.emplace_back(G[v], G[get_key(get_target(e))],
+                                get_weight(e), get_resources(e), &e,
+                                residual_forward);
+
+  // The working paths.
+  std::vector<std::vector<const edge_type *>> ws;
+  {
+    residual_edge<edge_type> ie(G[src], G[src], 0, r, nullptr,
+                                residual_forward);
+    label_type initial({0, r}, ie);
+    residual_functor<edge_type> f{width, 0};
+    generic_permanent<label_type> P(n);
+    generic_tentative<label_type> T(n);
+
+    for(const auto &l: generic_search(P, T, f, initial, dst))
+      {
+        auto &w = ws.emplace_back();
+        for(const auto *re: residual_path(P, f, l, initial))
+          w.push_back(re->m_e);
+        if (ws.size() == working)
+          break;
+      }
+  }
+
+  std::vector<std::size_t> at(n, std::size_t(-1));
+
+  // The edges of the working path, sorted.
+  std::vector<const edge_type *> sw;
+
+  for(const auto &w: ws)
+    {
+      sw = w;
+      std::ranges::sort(sw);
+
+      // The residual graph of working path w.
+      residual_graph<edge_type> R(n);
+      for(std::size_t v = 0; v < n; ++v)
+        for(const auto &e: G[v].m_edges)
+          if (!std::ranges::binary_search(sw, e.m_e))
+            R[v].m_edges.emplace_back(R[v], R[get_key(get_target(e))],
+                                      get_weight(e), get_resources(e),
+                                      e.m_e, residual_forward);
+      for(std::size_t i = 0; i < w.size(); ++i)
+        {
+          auto s = get_key(get_source(*w[i]));
+          auto t = get_key(get_target(*w[i]));
+          R[t].m_edges.emplace_back(R[t], R[s],
+                                    -weight_type(get_weight(*w[i])), r,
+                                    w[i], i);
+        }
+
+      residual_edge<edge_type> ie(R[src], R[src], 0, r, nullptr,
+                                  residual_forward);
+      label_type initial({0, r}, ie);
+      residual_functor<edge_type> f{width,
+                                    static_cast<unsigned>(w.size())};
+      generic_pareto<label_type> P(n);
+      generic_label_correcting(P, f, initial, dst, lc_order::fifo, false);
+
+      for(const auto &l: P[dst])
+        if (auto p = make_disjoint_pair(w, residual_path(P, f, l, initial),
+                                        src, dst, r, width, at))
+          {
+            if (std::ranges::any_of(result, [&](const auto &q)
+            {
+              return boe(q, *p);
+            }))
+              continue;
+
+            std::erase_if(result, [&](const auto &q)
+            {
+              return boe(*p, q);
+            });
+            result.push_back(std::move(*p));
+          }
+    }
+
+  std::ranges::sort(result, {}, &disjoint_pair<edge_type>::m_weight);
+
+  return result;
+}
+
+#endif // GENERIC_DISJOINT_HPP
@@ -0,0 +1,187 @@
+#ifndef GENERIC_EDGE_SUMMARY_HPP
+#define GENERIC_EDGE_SUMMARY_HPP
+
+#include "generic_label_creator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The length of the largest contiguous run of units in r: for
+// contiguous resources (of min and max), and for the resources that
+// are a range of contiguous resources.
+template <typename Resources>
+unsigned
+largest_run(const Resources &r)
+{
+  if constexpr (requires {r.min(); r.max();})
+    return r.empty() ? 0 : r.max() - r.min();
+  else
+    {
+      unsigned l = 0;
+      for(const auto &cu: r)
+        l = std::max(l, largest_run(cu));
+      return l;
+    }
+}
+
+// The summary of resources: a coarse bitmap, and the largest run.
+// The units are split into 64 blocks of m_block units, and bit b of
+// the bitmap is set if there is a unit in block b.
+//
+// If the bitmaps of two resources have no bits in common, their
+// intersection is empty, and the largest run of their intersection is
+// at most the smaller of their largest runs.  The summaries can tell
+// that the intersection is useless, but not that it is useful.
+struct resources_summary
+{
+  std::uint64_t m_blocks = 0;
+  unsigned m_largest = 0;
+};
+
+// The bitmap of the blocks that contiguous units [min, max) span.
+// The units past the 64 blocks go to the last block: then the bitmaps
+// tell less, but they still have a bit in common if the units
+// intersect.
+inline std::uint64_t
+summary_blocks(unsigned min, unsigned max, unsigned block)
+{
+  assert(min < max && block);
+  unsigned b0 = std::min(min / block, 63U);
+  unsigned b1 = std::min((max - 1) / block, 63U);
+
+  // The bits from b0 to b1, inclusive.
+  std::uint64_t h = b1 == 63 ? ~std::uint64_t(0) :
+    (std::uint64_t(1) << (b1 + 1)) - 1;
+  return h & ~((std::uint64_t(1) << b0) - 1);
+}
+
+template <typename Resources>
+resources_summary
+summarize(const Resources &r, unsigned block)
+{
+  resources_summary s;
+
+  if constexpr (requires {r.min(); r.max();})
+    {
+      if (!r.empty())
+        s.m_blocks = summary_blocks(r.min(), r.max(), block);
+    }
+  else
+    for(const auto &cu: r)
+      s.m_blocks |= summarize(cu, block).m_blocks;
+
+  s.m_largest = largest_run(r);
+
+  return s;
+}
+
+// Can the intersection of the resources of the given summaries have a
+// run of the given width?
+inline bool
+may_fit(const resources_summary &a, const resources_summary &b,
+        unsigned width)
+{
+  return (a.m_blocks & b.m_blocks) &&
+    std::min(a.m_largest, b.m_largest) >= std::max(width, 1U);
+}
+
+// The summaries of the resources of edges, looked up with the key of
+// an edge.  The summary of an edge has to be updated when the
+// resources of the edge change.
+struct generic_edge_summaries: std::vector<resources_summary>
+{
+  // The base type.
+  using base_type = std::vector<resources_summary>;
+  // The size type of the base type.
+  using size_type = typename base_type::size_type;
+
+  // The number of units in a block.
+  unsigned m_block;
+
+  // There are count edges, and units are below the given number.
+  generic_edge_summaries(size_type count, unsigned units):
+    base_type(count), m_block(std::max((units + 63) / 64, 1U))
+  {
+  }
+
+  // Updates the summary of edge e.
+  template <typename Edge>
+  void
+  update(const Edge &e)
+  {
+    base_type::operator[](get_key(e)) =
+      summarize(get_resources(e), m_block);
+  }
+
+  template <typename Edge>
+  const resources_summary &
+  get(const Edge &e) const
+  {
+    return base_type::operator[](get_key(e));
+  }
+};
+
+// The label creator that rejects a label and an edge with a few bit
+// operations if their resources cannot have a run of the given width
+// in common.  Then the candidate resources are empty, as they are when
+// the intersection is empty, and the caller rejects them in the same
+// way.  Otherwise, the candidate is produced by generic_label_creator.
+//
+// The summary of the resources of a label is computed for every call
+// of the creator, but for_label(l) gives the creator of the
+// relaxations of label l, which computes it once (see label_functor
+// of generic_search.hpp).
+struct generic_summary_creator
+{
+  std::reference_wrapper<const generic_edge_summaries> m_s;
+  // The width of the demand.
+  unsigned m_width;
+
+  generic_summary_creator(const generic_edge_summaries &s,
+                          unsigned width):
+    m_s(s), m_width(width)
+  {
+  }
+
+  template <typename Label, typename Edge>
+  auto
+  operator()(const Label &l, const Edge &e) const
+  {
+    return create(l, summarize(get_resources(l), m_s.get().m_block), e);
+  }
+
+  // The creator of the relaxations of label l, which is valid as long
+  // as l and this creator are.
+  template <typename Label>
+  auto
+  for_label(const Label &l) const
+  {
+    return [this, &l, s = summarize(get_resources(l), m_s.get().m_block)]
+      (const auto &e)
+    {
+      return create(l, s, e);
+    };
+  }
+
+  // The candidate of label l of summary s, and edge e.
+  template <typename Label, typename Edge>
+  auto
+  create(const Label &l, const resources_summary &s, const Edge &e) const
+  {
+    using resources_type =
+      std::remove_cvref_t<decltype(get_resources(l))>;
+
+    if (!may_fit(s, m_s.get().get(e), m_width))
+      return std::make_pair(get_weight(l) + get_weight(e),
+                            resources_type());
+
+    return generic_label_creator()(l, e);
+  }
+};
+
+#endif // GENERIC_EDGE_SUMMARY_HPP
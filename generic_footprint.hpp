@@ -0,0 +1,417 @@
+#ifndef GENERIC_FOOTPRINT_HPP
+#define GENERIC_FOOTPRINT_HPP
+
+#include "generic_boe_batch.hpp"
+#include "generic_permanent.hpp"
+#include "generic_permanent2.hpp"
+#include "generic_probe.hpp"
+#include "generic_tentative.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// The memory of the containers of labels: how many labels they have,
+// how the labels are spread over the keys, and how many bytes they
+// allocated.  The containers (generic_permanent, generic_permanent2,
+// generic_tentative, and the like) are vectors of the containers of
+// the labels of a key: vectors (or small vectors) of labels, or sets
+// of labels.
+//
+// We do not know how many bytes the allocator takes for a node of a
+// set, and so we estimate it: a node has the color and three pointers
+// (as in libstdc++ and libc++) and the value, and the allocator adds a
+// pointer, and rounds up to 16 bytes (as glibc malloc does).  A node
+// of an unordered map has a pointer and the value.
+//
+// Besides the labels, the containers keep what they need to compare
+// the labels with the boe kernels: the columns of the labels, and the
+// slots of the labels in the columns (see generic_boe_batch.hpp).  We
+// count them too, since for a key of a few labels they take more than
+// the labels.
+
+// The estimated bytes of a node of a set of T.
+template <typename T>
+constexpr std::size_t
+footprint_node_bytes()
+{
+  return (4 * sizeof(void *) + sizeof(T) + sizeof(void *) + 15) / 16 * 16;
+}
+
+// The estimated bytes of a node of an unordered map of value type T.
+template <typename T>
+constexpr std::size_t
+footprint_hash_node_bytes()
+{
+  return (sizeof(void *) + sizeof(T) + sizeof(void *) + 15) / 16 * 16;
+}
+
+// The bytes of the columns of a label, not counting the unused lanes
+// of the last group of a key.
+template <typename Label>
+constexpr std::size_t
+footprint_column_bytes()
+{
+  return boe_columns<Label>::F * sizeof(std::uint32_t);
+}
+
+// The bytes that a label takes in the container of a key of type VD,
+// not counting the slack of vectors.
+template <typename VD>
+constexpr std::size_t
+footprint_label_bytes()
+{
+  using T = typename VD::value_type;
+
+  if constexpr (requires (const VD &vd) {vd.capacity();})
+    return sizeof(T);
+  else
+    return footprint_node_bytes<T>();
+}
+
+struct container_footprint
+{
+  // The number of keys.
+  std::size_t m_keys = 0;
+  // The number of labels of all keys.
+  std::size_t m_labels = 0;
+  // The most labels the container had at once, if the container
+  // keeps track of it (as generic_tentative does), and otherwise
+  // m_labels, as for the permanent labels, which only grow.
+  std::size_t m_peak_labels = 0;
+  // The largest number of labels of a key.
+  std::size_t m_max_labels = 0;
+  // The number of keys by the number of their labels: m_histogram[0]
+  // is for no labels, and m_histogram[b] for b > 0 is for [2^(b - 1),
+  // 2^b) labels.
+  std::array<std::size_t, 65> m_histogram{};
+  // The bytes allocated, with the vector of the keys.
+  std::size_t m_bytes = 0;
+  // The bytes allocated for the labels that are not there: the spare
+  // capacity of vectors.  Included in m_bytes.
+  std::size_t m_slack_bytes = 0;
+  // The bytes of the columns and the slots of the labels.  Included
+  // in m_bytes.
+  std::size_t m_side_bytes = 0;
+};
+
+// The container keeps side data of the given bytes.
+inline void
+add_side_footprint(container_footprint &f, std::size_t bytes)
+{
+  f.m_bytes += bytes;
+  f.m_side_bytes += bytes;
+}
+
+// The bytes of columns c.
+template <typename Label>
+std::size_t
+columns_bytes(const boe_columns<Label> &c)
+{
+  return c.m_c.capacity() * sizeof(std::uint32_t);
+}
+
+// The bytes that the container of a key allocated, and how many of
+// them are spare.
+template <typename VD>
+void
+add_footprint(container_footprint &f, const VD &vd)
+{
+  using T = typename VD::value_type;
+  auto n = vd.size();
+
+  f.m_labels += n;
+  f.m_max_labels = std::max(f.m_max_labels, n);
+  ++f.m_histogram[std::bit_width(n)];
+
+  if constexpr (requires {vd.capacity();})
+    {
+      // The labels of a small vector can be inline, and then they
+      // are counted with the vector of the keys.
+      if constexpr (requires {vd.is_inline();})
+        if (vd.is_inline())
+          return;
+
+      f.m_bytes += vd.capacity() * sizeof(T);
+      f.m_slack_bytes += (vd.capacity() - n) * sizeof(T);
+    }
+  else
+    f.m_bytes += n * footprint_node_bytes<T>();
+}
+
+// The footprint of the keys of container c: of the vector of the keys,
+// and of the containers of their labels.  Goes through all keys, and
+// so call it after a search, or now and then.
+template <typename C>
+container_footprint
+footprint_keys(const C &c)
+{
+  using VD = typename C::value_type;
+  container_footprint f;
+
+  f.m_keys = c.size();
+  f.m_bytes = c.capacity() * sizeof(VD);
+  f.m_slack_bytes = (c.capacity() - c.size()) * sizeof(VD);
+
+  for(const auto &vd: c)
+    add_footprint(f, vd);
+
+  f.m_peak_labels = f.m_labels;
+
+  return f;
+}
+
+template <typename VD, typename Allocator>
+container_footprint
+footprint(const std::vector<VD, Allocator> &c)
+{
+  return footprint_keys(c);
+}
+
+// The permanent labels have also the columns of the keys that have
+// enough labels.
+template <typename Label, typename VD>
+container_footprint
+footprint(const generic_permanent<Label, VD> &P)
+{
+  auto f = footprint_keys(P);
+
+  if constexpr (generic_permanent<Label, VD>::columnar)
+    {
+      add_side_footprint(f, P.m_columns.capacity() *
+                         sizeof(boe_columns<Label>));
+      for(const auto &c: P.m_columns)
+        add_side_footprint(f, columns_bytes(c));
+    }
+
+  return f;
+}
+
+// The permanent labels have also the columns of every key, and the
+// pointers to the labels in the order of the columns.
+template <typename Label>
+container_footprint
+footprint(const generic_permanent2<Label> &P)
+{
+  using slots_type = typename generic_permanent2<Label>::slots_type;
+
+  auto f = footprint_keys(P);
+
+  if constexpr (generic_permanent2<Label>::columnar)
+    {
+      add_side_footprint(f, P.m_slots.capacity() * sizeof(slots_type));
+      for(const auto &sl: P.m_slots)
+        add_side_footprint(f, columns_bytes(sl.m_c) +
+                           sl.m_ls.capacity() * sizeof(sl.m_ls[0]));
+    }
+
+  return f;
+}
+
+// The tentative labels have also the priority queue of keys, the
+// columns of every key, the iterators to the labels in the order of
+// the columns, and the slots of the labels.  They keep track of their
+// peak.
+template <typename Label>
+container_footprint
+footprint(const generic_tentative<Label> &T)
+{
+  using base_type = typename generic_tentative<Label>::base_type;
+  using size_type = typename generic_tentative<Label>::size_type;
+  using slots_type = typename generic_tentative<Label>::slots_type;
+  using slot_type = typename decltype(T.m_slot_of)::value_type;
+
+  auto f = footprint(static_cast<const base_type &>(T));
+  f.m_bytes += T.m_pq.size() * footprint_node_bytes<size_type>();
+  f.m_peak_labels = T.peak_label_count();
+
+  if constexpr (generic_tentative<Label>::columnar)
+    {
+      add_side_footprint(f, T.m_slots.capacity() * sizeof(slots_type));
+      for(const auto &sl: T.m_slots)
+        add_side_footprint(f, columns_bytes(sl.m_c) +
+                           sl.m_its.capacity() * sizeof(sl.m_its[0]));
+      add_side_footprint(f, T.m_slot_of.size() *
+                         footprint_hash_node_bytes<slot_type>() +
+                         T.m_slot_of.bucket_count() * sizeof(void *));
+    }
+
+  return f;
+}
+
+// The estimated bytes of the keys of container c of the given number
+// of labels, in constant time: of the vector of the keys, and of the
+// labels.
+template <typename C>
+std::size_t
+footprint_keys_estimate(const C &c, std::size_t labels)
+{
+  using VD = typename C::value_type;
+
+  return c.capacity() * sizeof(VD) +
+    labels * footprint_label_bytes<VD>();
+}
+
+// The estimated bytes of container c of the given number of labels,
+// in constant time, for memory_limit_probe.  The estimate counts what
+// footprint counts, but not the slack of vectors.
+template <typename C>
+std::size_t
+footprint_estimate(const C &c, std::size_t labels)
+{
+  return footprint_keys_estimate(c, labels);
+}
+
+// We count the columns of every label, though the keys of a few
+// labels have none.
+template <typename Label, typename VD>
+std::size_t
+footprint_estimate(const generic_permanent<Label, VD> &P,
+                   std::size_t labels)
+{
+  auto bytes = footprint_keys_estimate(P, labels);
+
+  if constexpr (generic_permanent<Label, VD>::columnar)
+    bytes += P.m_columns.capacity() * sizeof(boe_columns<Label>) +
+      labels * footprint_column_bytes<Label>();
+
+  return bytes;
+}
+
+template <typename Label>
+std::size_t
+footprint_estimate(const generic_permanent2<Label> &P, std::size_t labels)
+{
+  using slots_type = typename generic_permanent2<Label>::slots_type;
+
+  auto bytes = footprint_keys_estimate(P, labels);
+
+  if constexpr (generic_permanent2<Label>::columnar)
+    bytes += P.m_slots.capacity() * sizeof(slots_type) +
+      labels * (footprint_column_bytes<Label>() + sizeof(const Label *));
+
+  return bytes;
+}
+
+template <typename Label>
+std::size_t
+footprint_estimate(const generic_tentative<Label> &T, std::size_t labels)
+{
+  using size_type = typename generic_tentative<Label>::size_type;
+  using slots_type = typename generic_tentative<Label>::slots_type;
+  using slot_type = typename decltype(T.m_slot_of)::value_type;
+  using iterator = typename generic_tentative<Label>::vd_type::const_iterator;
+
+  auto bytes = footprint_keys_estimate(T, labels) +
+    T.m_pq.size() * footprint_node_bytes<size_type>();
+
+  if constexpr (generic_tentative<Label>::columnar)
+    bytes += T.m_slots.capacity() * sizeof(slots_type) +
+      labels * (footprint_column_bytes<Label>() + sizeof(iterator) +
+                footprint_hash_node_bytes<slot_type>()) +
+      T.m_slot_of.bucket_count() * sizeof(void *);
+
+  return bytes;
+}
+
+inline std::ostream &
+operator << (std::ostream &out, const container_footprint &f)
+{
+  out << "keys = " << f.m_keys << ", labels = " << f.m_labels
+      << ", peak labels = " << f.m_peak_labels
+      << ", max labels = " << f.m_max_labels
+      << ", bytes = " << f.m_bytes
+      << ", slack bytes = " << f.m_slack_bytes
+      << ", side bytes = " << f.m_side_bytes << ", histogram =";
+
+  // The buckets up to the last used one.
+  std::size_t e = f.m_histogram.size();
+  while(e > 1 && !f.m_histogram[e - 1])
+    --e;
+  for(std::size_t b = 0; b < e; ++b)
+    out << ' ' << f.m_histogram[b];
+
+  return out;
+}
+
+// How a search ended.
+enum class search_status
+  {
+    // The search went through all labels, or the caller stopped it.
+    complete,
+    // The search was stopped because it took too much memory.
+    memory_limit
+  };
+
+// The memory limit of a search, and what the search used.  Owned by
+// the caller, since the search takes the probe by value.
+struct memory_budget
+{
+  // The limit of the bytes of the permanent and the tentative labels,
+  // or 0 for no limit.
+  std::size_t m_limit = 0;
+
+  search_status m_status = search_status::complete;
+  // The most bytes the labels took.
+  std::size_t m_peak_bytes = 0;
+  // The most tentative labels.
+  std::size_t m_peak_tentative = 0;
+  // The number of permanent labels.
+  std::size_t m_permanent = 0;
+};
+
+// The probe that stops generic_search when the labels take more bytes
+// than the limit of the budget.  This is a soft limit: we estimate
+// the bytes in constant time with the numbers of labels (see
+// footprint_estimate), and so we do not count the slack of vectors,
+// which footprint counts.  The tentative labels are counted only if
+// the tentative container can count them (as generic_tentative can).
+struct memory_limit_probe: null_probe
+{
+  memory_budget *m_b;
+  // The current number of tentative labels.
+  std::size_t m_tentative = 0;
+
+  memory_limit_probe(memory_budget &b): m_b(&b)
+  {
+  }
+
+  void
+  start()
+  {
+    m_b->m_status = search_status::complete;
+    m_b->m_peak_bytes = m_b->m_peak_tentative = m_b->m_permanent = 0;
+  }
+
+  void
+  popped(std::size_t tentative)
+  {
+    ++m_b->m_permanent;
+    m_tentative = tentative;
+    m_b->m_peak_tentative = std::max(m_b->m_peak_tentative, tentative);
+  }
+
+  template <typename Permanent, typename Tentative>
+  bool
+  stop(const Permanent &P, const Tentative &T)
+  {
+    std::size_t bytes = footprint_estimate(P, m_b->m_permanent) +
+      footprint_estimate(T, m_tentative);
+
+    m_b->m_peak_bytes = std::max(m_b->m_peak_bytes, bytes);
+
+    if (m_b->m_limit && bytes > m_b->m_limit)
+      {
+        m_b->m_status = search_status::memory_limit;
+        return true;
+      }
+
+    return false;
+  }
+};
+
+#endif // GENERIC_FOOTPRINT_HPP
@@ -4,6 +4,8 @@
 #include "props.hpp"
 
 #include <iostream>
+#include <ranges>
+#include <utility>
 
 // The label has weight c, and resources r.
 
@@ -15,6 +17,13 @@ struct generic_label: weight<Weight>, resources<Resources>
   {
   }
 
+  // Builds the label from the (weight, resources) pair produced by
+  // generic_label_creator.
+  generic_label(std::pair<Weight, Resources> &&p):
+    weight<Weight>(p.first), resources<Resources>(std::move(p.second))
+  {
+  }
+
   bool operator == (const generic_label &) const = default;
 
   // If i < j, then i is better than j.
@@ -40,13 +49,22 @@ struct generic_label: weight<Weight>, resources<Resources>
   }
 };
 
+// Is weight a better than or equal to weight b?  The weights of
+// several criteria overload it, e.g., weight_vector.
+template <typename Weight>
+bool
+weight_boe(const Weight &a, const Weight &b)
+{
+  return a <= b;
+}
+
 // The "better or equal" function.
 template <typename Weight, typename Resources>
 bool
 boe(const generic_label<Weight, Resources> &i,
     const generic_label<Weight, Resources> &j)
 {
-  return get_weight(i) <= get_weight(j) &&
+  return weight_boe(get_weight(i), get_weight(j)) &&
     includes(get_resources(i), get_resources(j));
 }
 
@@ -57,9 +75,9 @@ boe(const generic_label<Weight, Resources> &i,
 //
 // * boe-incomparable, i.e., there are no labels l1, l2 in C such that
 //   boe(l1, l2) holds.
-template <template<typename...> typename C, typename Label>
+template <std::ranges::input_range C, typename Label>
 bool
-boe(const C<Label> &c, const Label &j)
+boe(const C &c, const Label &j)
 {
   // We don't have to iterate through all labels since they are sorted
   // with <.  We stop when further search is futile.
@@ -0,0 +1,91 @@
+#ifndef GENERIC_LABEL_CORRECTING_HPP
+#define GENERIC_LABEL_CORRECTING_HPP
+
+#include "generic_label.hpp"
+#include "generic_pareto.hpp"
+#include "graph_interface.hpp"
+
+#include <deque>
+#include <utility>
+
+// The order in which the label-correcting search processes the
+// labels.
+enum class lc_order
+  {
+    // First in, first out.
+    fifo,
+    // Small label first: a label less than the label at the front of
+    // the queue goes to the front, and otherwise to the back.
+    slf
+  };
+
+// The label-correcting search: the alternative to generic_search for
+// the graphs where the priority queue costs more than it saves, e.g.,
+// the sparse graphs of small diameter.
+//
+// Generic Dijkstra (label-setting) processes the labels in the order
+// of <, and so a processed label is permanent.  Here we process the
+// labels in the order of lc_order, and so a processed label can later
+// be replaced by a better one, whose candidates we then produce too.
+// We process more labels, but we pay nothing for the order.  A label
+// is final when the search is done, and so the search is not lazy:
+// it returns when all labels were processed.
+//
+// The labels are kept in P, and the queue has copies of them.  When a
+// label is replaced in P, its copy in the queue is skipped.  When the
+// search is done, P[dst] has the labels of the target vertex, and the
+// path of label l of P[dst] is generic_path_range(P, f, l, initial),
+// as for generic_search.  The other keys can have fewer labels than
+// they would in generic_search, because we drop the labels that a
+// label of the target is better than or equal to: their paths to the
+// target would be worse than or equal to it.
+//
+// The weights can be negative, if there are no negative cycles, or if
+// the functor and boe keep a label from replacing the label it came
+// from around a cycle (as in generic_disjoint.hpp).  Then do not
+// prune: a label worse than a label of the target can lead to a
+// better one, and so can the labels that it would replace.
+template <typename Label, typename Functor, typename Key>
+void
+generic_label_correcting(generic_pareto<Label> &P, Functor f,
+                         const Label &initial, Key dst,
+                         lc_order order = lc_order::fifo,
+                         bool prune = true)
+{
+  std::deque<Label> Q;
+
+  P.insert(initial);
+  Q.push_back(initial);
+
+  while(!Q.empty())
+    {
+      Label l = std::move(Q.front());
+      Q.pop_front();
+
+      // The label was replaced after it was queued.
+      if (!P.contains(l))
+        continue;
+
+      // The vertex of the label.
+      const auto &v = get_target(get_edge(l));
+
+      // We do not go past the target vertex, as generic_search does
+      // not.
+      if (get_key(v) == dst)
+        continue;
+
+      for(const auto &e: get_edges(v))
+        for(auto &&c: f(l, e))
+          {
+            if ((prune && boe(P[dst], c)) || !P.insert(c))
+              continue;
+
+            if (order == lc_order::slf && !Q.empty() && c < Q.front())
+              Q.push_front(std::move(c));
+            else
+              Q.push_back(std::move(c));
+          }
+    }
+}
+
+#endif // GENERIC_LABEL_CORRECTING_HPP
@@ -0,0 +1,224 @@
+#ifndef GENERIC_LAZY_TENTATIVE_HPP
+#define GENERIC_LAZY_TENTATIVE_HPP
+
+#include "generic_boe_batch.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+// The container type for storing the generic tentative labels that
+// defers the dominance checks.  It is an alternative to
+// generic_tentative, and it pops the smallest label (as compared with
+// <) too.
+//
+// Container generic_tentative eagerly purges the labels that are
+// worse than or equal to a pushed label.  Here, we only append the
+// pushed label to a binary heap, because many labels are popped soon
+// anyway.  The dominated labels are dropped:
+//
+// * at pop time, with function purge, by checking the permanent
+//   labels: a label that has a better or equal permanent label is
+//   dropped,
+//
+// * periodically, by compacting the labels of the keys whose numbers
+//   of pending labels exceed their limits.  We do not compact a key
+//   as soon as it exceeds its limit, since that goes through the whole
+//   heap.  We mark the key instead, and at pop time, once the marked
+//   keys have at least half of the labels of the heap, we compact them
+//   all in one go through the heap, so that the cost of going through
+//   the heap is amortized over the compacted labels.
+//
+// Since we do not keep the labels of a key together, we do not answer
+// whether there is a better or equal tentative label: function
+// has_better_or_equal always returns false.
+template <typename Label>
+struct generic_lazy_tentative
+{
+  // The label type.
+  using label_type = Label;
+  // The size type.
+  using size_type = typename std::vector<label_type>::size_type;
+
+  // The binary heap of labels with the smallest label on top.
+  std::vector<label_type> m_heap;
+  // The number of pending labels for every key.
+  std::vector<size_type> m_pending;
+  // The number of pending labels of a key at which we mark the key
+  // for compaction.
+  std::vector<size_type> m_limit;
+  // The initial limit of every key.
+  size_type m_threshold;
+  // Is the key marked for compaction?
+  std::vector<bool> m_marked;
+  // The number of pending labels of the marked keys.
+  size_type m_marked_labels = 0;
+
+  generic_lazy_tentative(size_type count, size_type threshold = 64):
+    m_pending(count), m_limit(count, threshold), m_threshold(threshold),
+    m_marked(count)
+  {
+  }
+
+  // Pushes a new label.  We do not return a reference to the label,
+  // because the labels move in the heap.
+  template<typename T>
+  void
+  push(T &&l)
+  {
+    // The key of the label.
+    auto key = get_key(l);
+
+    m_heap.push_back(std::forward<T>(l));
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+
+    ++m_pending[key];
+    if (m_marked[key])
+      ++m_marked_labels;
+    else if (m_pending[key] > m_limit[key])
+      {
+        m_marked[key] = true;
+        m_marked_labels += m_pending[key];
+      }
+  }
+
+  bool
+  empty() const
+  {
+    return m_heap.empty();
+  }
+
+  // Here we return a label by value.
+  auto
+  pop()
+  {
+    assert(!m_heap.empty());
+    std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+    auto l = std::move(m_heap.back());
+    m_heap.pop_back();
+
+    // The key of the label.
+    auto key = get_key(l);
+
+    assert(m_pending[key]);
+    --m_pending[key];
+    if (m_marked[key])
+      {
+        --m_marked_labels;
+        // The key has nothing to compact.
+        if (!m_pending[key])
+          m_marked[key] = false;
+      }
+
+    if (m_marked_labels && 2 * m_marked_labels >= m_heap.size())
+      compact();
+
+    return l;
+  }
+
+  // Drops the labels from the top of the heap that have better or
+  // equal labels in P.  Call it before empty and pop, so that only the
+  // labels that should become permanent are popped.
+  template <typename Permanent>
+  void
+  purge(const Permanent &P)
+  {
+    while(!m_heap.empty() && has_better_or_equal(P, m_heap.front()))
+      pop();
+  }
+
+private:
+  // Removes the pending labels of the marked keys that are worse than
+  // or equal to the other pending labels of their keys.
+  void
+  compact()
+  {
+    // Move the labels of the marked keys to the back.
+    auto b = std::partition(m_heap.begin(), m_heap.end(),
+                            [this](const auto &l)
+                            {return !m_marked[get_key(l)];});
+
+    // Sort them by key, and then with <, so that a label can be worse
+    // than or equal to the labels of its key that come before it only.
+    std::sort(b, m_heap.end(), [](const auto &i, const auto &j)
+    {
+      return get_key(i) != get_key(j) ? get_key(i) < get_key(j) : i < j;
+    });
+
+    // The labels in [b, e) are boe-incomparable for every key, and
+    // the labels of the current key start at k.  For the labels that
+    // the kernels compare, we lay out the kept labels of the current
+    // key in columns as we go, and compare label i with them in
+    // batches.
+    [[maybe_unused]] boe_columns<label_type> c;
+    auto e = b, k = b;
+    for(auto i = b; i != m_heap.end(); ++i)
+      {
+        if (i == b || get_key(*i) != get_key(*k))
+          {
+            if (i != b)
+              done(get_key(*k), e - k);
+            k = e;
+            if constexpr (boe_columnar<label_type>)
+              c.clear();
+          }
+
+        bool dominated;
+
+        if constexpr (boe_columnar<label_type>)
+          dominated = boe_any(c, e - k, *i,
+                              [&k](std::size_t n) -> const label_type &
+                              {
+                                return k[n];
+                              });
+        else
+          dominated = boe(std::ranges::subrange(k, e), *i);
+
+        if (!dominated)
+          {
+            if (e != i)
+              *e = std::move(*i);
+            if constexpr (boe_columnar<label_type>)
+              c.push_back(*e);
+            ++e;
+          }
+      }
+
+    if (k != e)
+      done(get_key(*k), e - k);
+
+    assert(!m_marked_labels);
+    m_heap.erase(e, m_heap.end());
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+  }
+
+  // The key is compacted, and has n pending labels.
+  void
+  done(size_type key, size_type n)
+  {
+    assert(m_marked[key]);
+    m_marked[key] = false;
+    m_marked_labels -= m_pending[key];
+    m_pending[key] = n;
+
+    // We double the limit, so that the compaction cost is amortized
+    // over the pushed labels.
+    m_limit[key] = std::max(m_threshold, 2 * n);
+  }
+};
+
+/**
+ * Is there in T a label that is better than or equal to label j?  We
+ * defer the dominance checks, and so we say there is none.
+ */
+template <typename Label>
+bool
+has_better_or_equal(const generic_lazy_tentative<Label> &, const Label &)
+{
+  return false;
+}
+
+#endif // GENERIC_LAZY_TENTATIVE_HPP
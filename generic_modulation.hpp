@@ -0,0 +1,128 @@
+#ifndef GENERIC_MODULATION_HPP
+#define GENERIC_MODULATION_HPP
+
+#include "generic_edge_summary.hpp"
+#include "generic_label_creator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The width of a demand can depend on the length of its path: a more
+// efficient modulation format needs fewer units, but reaches shorter.
+// Instead of a search per format, a single search can take the
+// distance-to-width table, and discard a label only if its resources
+// cannot fit the width of the most efficient format that the label
+// can still use.  The weight of the label is the length of its path,
+// and it does not decrease along a path, so the formats that a label
+// can use only get fewer and wider.
+//
+// A label better than or equal to another can use every format that
+// the other can, since it is no longer and has no fewer units, and so
+// the search yields the Pareto labels for every format.
+
+// The format that the paths of length up to m_reach can use, and that
+// then needs m_width units.
+template <typename Weight>
+struct modulation_format
+{
+  Weight m_reach;
+  unsigned m_width;
+
+  bool operator == (const modulation_format &) const = default;
+};
+
+// The distance-to-width table.
+template <typename Weight>
+struct modulation_table
+{
+  // The formats sorted by reach, and then by width, both increasing.
+  // A format that reaches no further than another, and needs no fewer
+  // units, is of no use, and is dropped.
+  std::vector<modulation_format<Weight>> m_formats;
+
+  modulation_table(std::vector<modulation_format<Weight>> fs)
+  {
+    // By reach decreasing, and then by width increasing, so that we
+    // keep a format only if it is narrower than those that reach
+    // further.
+    std::ranges::sort(fs, [](const auto &a, const auto &b)
+    {
+      return a.m_reach > b.m_reach ||
+        (a.m_reach == b.m_reach && a.m_width < b.m_width);
+    });
+
+    for(const auto &f: fs)
+      if (m_formats.empty() || f.m_width < m_formats.back().m_width)
+        m_formats.push_back(f);
+
+    std::ranges::reverse(m_formats);
+  }
+
+  // The most efficient format for the path of length w, or nullptr if
+  // no format reaches that far.
+  const modulation_format<Weight> *
+  best(const Weight &w) const
+  {
+    auto i = std::ranges::lower_bound(m_formats, w, {},
+                                      &modulation_format<Weight>::m_reach);
+
+    return i == m_formats.end() ? nullptr : &*i;
+  }
+
+  // Can the path of length w and of resources r use some format?
+  template <typename Resources>
+  bool
+  fits(const Weight &w, const Resources &r) const
+  {
+    auto f = best(w);
+
+    return f && largest_run(r) >= f->m_width;
+  }
+
+  // The formats that the path of length w and of resources r can use:
+  // those that reach w, and that fit in r.  The formats that reach w
+  // follow the best one, and they get wider, and so they are a range.
+  template <typename Resources>
+  std::span<const modulation_format<Weight>>
+  formats(const Weight &w, const Resources &r) const
+  {
+    auto i = std::ranges::lower_bound(m_formats, w, {},
+                                      &modulation_format<Weight>::m_reach);
+    auto e = std::ranges::upper_bound(i, m_formats.end(), largest_run(r),
+                                      {},
+                                      &modulation_format<Weight>::m_width);
+
+    return {i, e};
+  }
+};
+
+// The label creator that rejects a candidate that can use no format:
+// then the candidate resources are empty, as they are when the
+// intersection is empty, and the caller rejects them in the same way.
+template <typename Weight>
+struct generic_modulation_creator
+{
+  std::reference_wrapper<const modulation_table<Weight>> m_t;
+
+  generic_modulation_creator(const modulation_table<Weight> &t): m_t(t)
+  {
+  }
+
+  template <typename Label, typename Edge>
+  auto
+  operator()(const Label &l, const Edge &e) const
+  {
+    auto p = generic_label_creator()(l, e);
+
+    if (!p.second.empty() && !m_t.get().fits(p.first, p.second))
+      p.second = std::remove_cvref_t<decltype(p.second)>();
+
+    return p;
+  }
+};
+
+#endif // GENERIC_MODULATION_HPP
@@ -0,0 +1,107 @@
+#ifndef GENERIC_PACKED_LABEL_HPP
+#define GENERIC_PACKED_LABEL_HPP
+
+#include "generic_label.hpp"
+#include "generic_permanent2.hpp"
+
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+
+// The generic label for contiguous units (CU) whose bounds fit in
+// UnitBits bits, and whose weight fits in the remaining bits of a
+// 64-bit word.  The label behaves exactly as generic_label, but <,
+// ==, and generic_permanent2_cmp are single integer comparisons.
+//
+// We pack the label into one word that is ordered as the label:
+//
+// * the most significant bits hold the weight, because the weight is
+//   compared first,
+//
+// * the middle bits hold the min of the resources, because greater
+//   resources (compared with > for resources) start earlier,
+//
+// * the least significant bits hold the complement of the max of the
+//   resources, because greater resources end later.
+//
+// For generic_permanent2_cmp we need the order of resources first,
+// and then the weight, which is the same word rotated right by the
+// bits of the resources.
+template <typename Weight, typename Resources, unsigned UnitBits = 16>
+struct generic_packed_label: generic_label<Weight, Resources>
+{
+  static_assert(std::unsigned_integral<Weight>);
+  static_assert(0 < UnitBits && UnitBits < 32);
+
+  // The base type.
+  using base_type = generic_label<Weight, Resources>;
+  // The type of the packed word.
+  using packed_type = std::uint64_t;
+
+  // The number of bits of the resources, and of the weight.
+  static constexpr unsigned resources_bits = 2 * UnitBits;
+  static constexpr unsigned weight_bits = 64 - resources_bits;
+  // The largest value of a unit bound.
+  static constexpr packed_type unit_mask = (packed_type(1) << UnitBits) - 1;
+
+  // The packed word.
+  packed_type m_packed;
+
+  generic_packed_label(Weight w, const Resources &r):
+    base_type(w, r), m_packed(pack(w, r))
+  {
+  }
+
+  bool
+  operator == (const generic_packed_label &l) const
+  {
+    return m_packed == l.m_packed;
+  }
+
+  // If i < j, then i is better than j.
+  auto
+  operator <=> (const generic_packed_label &l) const
+  {
+    return m_packed <=> l.m_packed;
+  }
+
+  static packed_type
+  pack(Weight w, const Resources &r)
+  {
+    assert(packed_type(w) >> weight_bits == 0);
+    assert(r.min() <= unit_mask && r.max() <= unit_mask);
+
+    return packed_type(w) << resources_bits |
+      packed_type(r.min()) << UnitBits |
+      (unit_mask - packed_type(r.max()));
+  }
+};
+
+// Returns the word that establishes the order of generic_permanent2:
+// the resources first, then the weight.
+template <typename Weight, typename Resources, unsigned UnitBits>
+auto
+get_packed2(const generic_packed_label<Weight, Resources, UnitBits> &l)
+{
+  return std::rotr(l.m_packed,
+                   generic_packed_label<Weight, Resources,
+                                        UnitBits>::resources_bits);
+}
+
+// The packed labels and the types derived from them (e.g., the labels
+// with a key) are compared by generic_permanent2 with one integer
+// comparison.
+template <typename Label>
+  requires requires (const Label &l) { get_packed2(l); }
+struct generic_permanent2_cmp<Label>
+{
+  bool
+  operator()(const Label &a, const Label &b) const
+  {
+    return get_packed2(a) < get_packed2(b);
+  }
+};
+
+#endif // GENERIC_PACKED_LABEL_HPP
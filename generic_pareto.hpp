@@ -0,0 +1,80 @@
+#ifndef GENERIC_PARETO_HPP
+#define GENERIC_PARETO_HPP
+
+#include "generic_permanent.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// The container of the Pareto sets of labels, one set per key, for
+// the label-correcting search.  As in generic_permanent, the labels
+// of a key are sorted with <, and boe-incomparable, and so
+// has_better_or_equal and generic_path_range work as they do for
+// generic_permanent.  However, the labels can be inserted in any
+// order: a label is rejected if a label of the set is better than or
+// equal to it, and otherwise it replaces the labels it is better than
+// or equal to.
+//
+// Do not use push of generic_permanent, because it requires the
+// labels to be pushed in the order of <.
+template <typename Label>
+struct generic_pareto: generic_permanent<Label>
+{
+  // The label type.
+  using label_type = Label;
+  // The base type.
+  using base_type = generic_permanent<Label>;
+  // The size type of the base type.
+  using size_type = typename base_type::size_type;
+
+  generic_pareto(size_type count): base_type(count)
+  {
+  }
+
+  // Inserts label l, unless a label of its key is better than or
+  // equal to it.  Returns true if the label was inserted.
+  bool
+  insert(const label_type &l)
+  {
+    if (has_better_or_equal(*this, l))
+      return false;
+
+    // The labels of the key, which we change, and then lay out their
+    // columns again.
+    auto &vd = base_type::base_type::operator[](get_key(l));
+
+    // Only the labels that are not less than l can be worse than or
+    // equal to l, and they follow l in the order of <.  Usually no
+    // label is equal to l, since it would be better than or equal to
+    // l, but if boe looks at more than < does, they start at n too.
+    auto n = std::lower_bound(vd.begin(), vd.end(), l) - vd.begin();
+    auto e = std::remove_if(vd.begin() + n, vd.end(), [&l](const auto &j)
+    {
+      return boe(l, j);
+    });
+    vd.erase(e, vd.end());
+
+    vd.insert(vd.begin() + n, l);
+    base_type::reset_columns(get_key(l));
+
+    return true;
+  }
+
+  // Is label l in the container?  A label removed from the container
+  // cannot be inserted again, because the label that removed it (or a
+  // label better than or equal to that one) would reject it, and so a
+  // label equal to l is l.  We compare with == too, because boe can
+  // look at more than < does (e.g., at the reversed edges that the
+  // labels of generic_disjoint.hpp count), and then a label that
+  // removed l can be neither less nor greater than l.
+  bool
+  contains(const label_type &l) const
+  {
+    const auto &vd = base_type::operator[](get_key(l));
+    auto [b, e] = std::equal_range(vd.begin(), vd.end(), l);
+    return std::find(b, e, l) != e;
+  }
+};
+
+#endif // GENERIC_PARETO_HPP
@@ -3,7 +3,15 @@
 
 #include "graph_interface.hpp"
 
+#include <cassert>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 // Iterates over the labels of a path.
 template <typename Permanent, typename Functor>
@@ -12,12 +20,21 @@ struct generic_path_iterator
   // That's the label type we're using.
   using label_type = typename Permanent::label_type;
 
+  // The labels of a key are usually stored in P, and we refer to
+  // them, but they can also be decoded on demand (as in
+  // generic_compressed_permanent), and then we hold a label.
+  using labels_type =
+    decltype(std::declval<const Permanent &>()[std::size_t()]);
+  using holder_type = std::conditional_t
+    <std::is_reference_v<std::ranges::range_reference_t<labels_type>>,
+     std::reference_wrapper<const label_type>, label_type>;
+
   // The permanent labels.  In this we dig for the labels.
   const Permanent &m_P;
   // The functor that was used to create labels in m_P.
   const Functor &m_f;
-  // The label we currently point to.  The label is stored in m_P.
-  std::reference_wrapper<const label_type> m_l;
+  // The label we currently point to.
+  holder_type m_l;
 
   generic_path_iterator(const Permanent &P, const Functor &f,
                         const label_type &l):
@@ -26,7 +43,7 @@ struct generic_path_iterator
   }
 
   const label_type &
-  operator * ()
+  operator * () const
   {
     return m_l;
   }
@@ -41,7 +58,7 @@ struct generic_path_iterator
   operator ++ ()
   {
     // The edge of label m_l.
-    const auto &e = get_edge(m_l.get());
+    const auto &e = get_edge(**this);
     // The source of edge e.
     const auto &s = get_source(e);
 
@@ -50,7 +67,7 @@ struct generic_path_iterator
     assert(!labels.empty());
 
     // Here we keep track of what we found.
-    const label_type *ptr = nullptr;
+    std::optional<holder_type> found;
 
     // Now we iterate over the labels to see which label pl was used
     // to produce label m_l.
@@ -66,16 +83,16 @@ struct generic_path_iterator
         auto cls = m_f(pl, e);
 
         for(const auto &cl: cls)
-          if (cl == m_l)
+          if (cl == **this)
             {
               // Exactly one of the candidate labels must equal to
-              // label m_l, so ptr must be nullptr.
-              assert(ptr == nullptr);
-              ptr = &pl;
+              // label m_l, so we must have found nothing yet.
+              assert(!found);
+              found.emplace(pl);
             }
       }
 
-    m_l = *ptr;
+    m_l = std::move(*found);
 
     return *this;
   }
@@ -87,8 +104,7 @@ bool
 operator == (const generic_path_iterator<Permanent, Functor> &i1,
              const generic_path_iterator<Permanent, Functor> &i2)
 {
-  // With C++26, I shall say: get_edge(i1.m_l) == get_edge(i2.m_l);
-  return get_edge(i1.m_l.get()) == get_edge(i2.m_l.get());
+  return get_edge(*i1) == get_edge(*i2);
 }
 
 template <typename Permanent, typename Functor>
@@ -125,4 +141,33 @@ struct generic_path_range
   }
 };
 
+// Which of the initial labels does the path of label l start with?
+// Returns the index of the initial label that the path reaches, e.g.,
+// for the search of many sources (generic_multi_search).  We compare
+// the whole label, not only the edge, since the initial labels of a
+// source can share the loop edge, and differ in resources.
+//
+// We throw std::invalid_argument if the path starts with none of the
+// initial labels.  We tell it when we get stuck: the label of the loop
+// edge at the source of the path produces itself along that edge.
+template <typename Permanent, typename Functor, typename Initials>
+std::size_t
+generic_path_source(const Permanent &P, const Functor &f,
+                    const typename Permanent::label_type &l,
+                    const Initials &initials)
+{
+  for(generic_path_iterator i(P, f, l); ; )
+    {
+      for(std::size_t k = 0; k < std::size(initials); ++k)
+        if (get_edge(*i) == get_edge(initials[k]) && *i == initials[k])
+          return k;
+
+      const auto &e = get_edge(*i);
+      ++i;
+      if (get_edge(*i) == e)
+        throw std::invalid_argument("generic_path_source: no initial "
+                                    "label");
+    }
+}
+
 #endif // GENERIC_PATH_RANGE_HPP
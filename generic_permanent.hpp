@@ -1,31 +1,90 @@
 #ifndef GENERIC_PERMANENT_HPP
 #define GENERIC_PERMANENT_HPP
 
+#include "generic_boe_batch.hpp"
 #include "generic_label.hpp"
+#include "small_vector.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <ranges>
 #include <utility>
 #include <vector>
 
 // The container type for storing permanent generic labels.  All
 // labels for a given key are incomparable.  A key can have many
-// labels or none, so we store them in a container.
+// labels or none, so we store them in a container of type VD.
 //
 // We assume that the labels for a given key that are pushed into the
 // container are ordered with <.
-template <typename Label>
-struct generic_permanent: std::vector<std::vector<Label>>
+//
+// For the labels that the boe kernels compare (see
+// generic_boe_batch.hpp), we also keep the columns of the labels of
+// every key, so that has_better_or_equal compares a label with the
+// labels of its key in batches, and does not gather their fields at
+// every call.  The columns follow the labels, and so the labels can be
+// changed only with the functions of the container: the vector of the
+// keys is a protected base, and a key gives its labels read-only.
+//
+// A key gets its columns once it has boe_any_min labels, since
+// boe_any does not read the columns of fewer labels.  Most keys have
+// a few labels, and so they allocate no columns, which matters most
+// for the small vectors of generic_small_permanent.
+template <typename Label, typename VD = std::vector<Label>>
+struct generic_permanent: protected std::vector<VD>
 {
   // The label type.
   using label_type = Label;
   // The type of data a vertex has.
-  using vd_type = std::vector<label_type>;
+  using vd_type = VD;
   // The type of the vector of vertex data.
   using base_type = std::vector<vd_type>;
   // The size type of the base type.
   using size_type = typename base_type::size_type;
 
-  generic_permanent(size_type count): base_type(count)
+  using typename base_type::value_type;
+  using base_type::capacity;
+  using base_type::size;
+
+  // Do we keep the columns?
+  static constexpr bool columnar = boe_columnar<Label> &&
+    std::ranges::random_access_range<VD>;
+
+  // The columns of the labels of every key, if columnar.  The
+  // columns of a key are empty until it has boe_any_min labels.
+  std::vector<boe_columns<Label>> m_columns;
+
+  generic_permanent(size_type count):
+    base_type(count), m_columns(columnar ? count : 0)
+  {
+  }
+
+  // The labels of the key.
+  const vd_type &
+  operator[](size_type key) const
+  {
+    return base_type::operator[](key);
+  }
+
+  auto
+  begin() const
+  {
+    return base_type::begin();
+  }
+
+  auto
+  end() const
+  {
+    return base_type::end();
+  }
+
+  // The containers are equal if their keys have equal labels.
+  bool
+  operator == (const generic_permanent &P) const
   {
+    return static_cast<const base_type &>(*this) ==
+      static_cast<const base_type &>(P);
   }
 
   // Pushes back a label, and returns a reference to it.
@@ -35,21 +94,87 @@ struct generic_permanent: std::vector<std::vector<Label>>
   {
     // The key of the target vertex of the label.
     const auto &ti = get_key(l);
+    // The labels of the key.
+    auto &vd = base_type::operator[](ti);
     // Push the label back.
-    base_type::operator[](ti).push_back(std::forward<T>(l));
+    vd.push_back(std::forward<T>(l));
 
-    return base_type::operator[](ti).back();
+    if constexpr (columnar)
+      {
+        if (vd.size() == boe_any_min)
+          reset_columns(ti);
+        else if (vd.size() > boe_any_min)
+          m_columns[ti].push_back(vd.back());
+      }
+
+    return vd.back();
+  }
+
+  // Replaces the labels of the key with the labels of range r, which
+  // are sorted with <, e.g., when they are loaded from a snapshot.
+  // The container of the key is allocated once, if it can reserve.
+  template <typename R>
+  void
+  assign(size_type key, R &&r)
+  {
+    auto &vd = base_type::operator[](key);
+    vd.clear();
+    if constexpr (requires {vd.reserve(std::ranges::size(r));})
+      vd.reserve(std::ranges::size(r));
+    for(auto &&l: r)
+      vd.push_back(std::forward<decltype(l)>(l));
+    reset_columns(key);
+  }
+
+protected:
+  // Lays out the columns of the key again, after its labels were
+  // changed other than with push, e.g., by generic_pareto.  A key of
+  // fewer than boe_any_min labels gets no columns.
+  void
+  reset_columns(size_type key)
+  {
+    if constexpr (columnar)
+      {
+        const auto &vd = base_type::operator[](key);
+        auto &c = m_columns[key];
+        c.clear();
+        if (vd.size() >= boe_any_min)
+          for(const auto &l: vd)
+            c.push_back(l);
+      }
   }
 };
 
+// The permanent labels of a key are stored inline, next to the labels
+// of the other keys, as long as there are at most N of them.  Only the
+// keys with more labels allocate memory.
+template <typename Label, std::size_t N = 3>
+using generic_small_permanent =
+  generic_permanent<Label, small_vector<Label, N>>;
+
 /**
  * Is there in P a label that is better than or equal to label j?
  */
-template <typename Label>
+template <typename Label, typename VD>
 bool
-has_better_or_equal(const generic_permanent<Label> &P, const Label &j)
+has_better_or_equal(const generic_permanent<Label, VD> &P, const Label &j)
 {
-  return boe(P[get_key(j)], j);
+  const auto &c = P[get_key(j)];
+
+  if constexpr (generic_permanent<Label, VD>::columnar)
+    {
+      // The labels are sorted with <, and so only the labels up to
+      // the first label i such that j < i can be better than or equal
+      // to j.  We compare j with them in batches.
+      std::size_t n = std::upper_bound(c.begin(), c.end(), j) - c.begin();
+      return boe_any(P.m_columns[get_key(j)], n, j,
+                     [&c](std::size_t i) -> const Label &
+                     {
+                       return c[i];
+                     });
+    }
+  else
+    return boe(c, j);
 }
 
 #endif // GENERIC_PERMANENT_HPP
@@ -1,9 +1,14 @@
 #ifndef GENERIC_PERMANENT2_HPP
 #define GENERIC_PERMANENT2_HPP
 
+#include "generic_boe_batch.hpp"
+
+#include <algorithm>
 #include <cassert>
 #include <set>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // We have to decide how we compare labels when we store and search
@@ -45,9 +50,19 @@ struct generic_permanent2_cmp
 
 // The container type for storing permanent generic labels.  A key can
 // have many labels or none, so we store them in a sorted container.
+//
+// For the labels that the boe kernels compare (see
+// generic_boe_batch.hpp), we also keep the columns of the labels of
+// every key in the order they were pushed, and pointers to the labels
+// in that order, so that has_better_or_equal compares a label with
+// the labels of its key in batches.  The labels stay in the sets until
+// they are extracted with extract, which takes them out of the
+// columns too, so the pointers remain valid.  The vector of the keys
+// is a protected base, and a key gives its labels read-only, so that
+// nothing else can take the labels from behind the columns.
 template <typename Label>
 struct generic_permanent2:
-  std::vector<std::set<Label, generic_permanent2_cmp<Label>>>
+  protected std::vector<std::set<Label, generic_permanent2_cmp<Label>>>
 {
   // The label type.
   using label_type = Label;
@@ -57,11 +72,56 @@ struct generic_permanent2:
   using base = std::vector<std::set<label_type, cmp_type>>;
   // The size type of the base.
   using size_type = typename base::size_type;
+  // The node handle type.  Nodes of sets of labels do not depend on
+  // the comparison, so the nodes popped from generic_tentative are of
+  // this type too.
+  using node_type = typename base::value_type::node_type;
+
+  // The sets of generic_tentative compare with <.
+  static_assert(std::is_same_v<node_type,
+                typename std::set<label_type>::node_type>);
+
+  // Do we keep the columns?
+  static constexpr bool columnar = boe_columnar<Label>;
+
+  // The columns of the labels of a key, and the labels in that order.
+  struct slots_type
+  {
+    boe_columns<label_type> m_c;
+    std::vector<const label_type *> m_ls;
+  };
+
+  // The columns of every key, if columnar.
+  std::vector<slots_type> m_slots;
+
+  using typename base::value_type;
+  using base::capacity;
+  using base::size;
 
-  generic_permanent2(size_type count): base(count)
+  generic_permanent2(size_type count):
+    base(count), m_slots(columnar ? count : 0)
   {
   }
 
+  // The labels of the key.
+  const value_type &
+  operator[](size_type key) const
+  {
+    return base::operator[](key);
+  }
+
+  auto
+  begin() const
+  {
+    return base::begin();
+  }
+
+  auto
+  end() const
+  {
+    return base::end();
+  }
+
   // Pushes a new label, and returns a reference to it.  We return a
   // const reference because a label stays there for good unchanged.
   template <typename T>
@@ -75,23 +135,98 @@ struct generic_permanent2:
     // Just insert.
     auto [i, s] = vd.insert(std::forward<T>(l));
     assert(s);
+    add_slot(*i);
+    // Return reference to the inserted element.
+    return *i;
+  }
+
+  // Pushes the label held by node handle nh, and returns a reference
+  // to it.  The node is reused, so there is no allocation, and the
+  // label is not copied.
+  const label_type &
+  push(node_type &&nh)
+  {
+    assert(!nh.empty());
+    // The key of the label.
+    const auto &ti = get_key(nh.value());
+    // The vertex data.
+    auto &vd = base::operator[](ti);
+    // Just insert.
+    auto [i, s, n] = vd.insert(std::move(nh));
+    assert(s);
+    add_slot(*i);
     // Return reference to the inserted element.
     return *i;
   }
+
+  // Builds a new label in place from args (e.g., from the weight and
+  // resources produced by generic_label_creator), pushes it, and
+  // returns a reference to it.
+  template <typename... Args>
+  const label_type &
+  emplace(Args &&...args)
+  {
+    // We build the label in a node of its own, because we need the
+    // key of the label to know where to insert it.
+    typename base::value_type vd;
+    vd.emplace(std::forward<Args>(args)...);
+    return push(vd.extract(vd.begin()));
+  }
+
+  // Extracts the label that iterator i of its key points to, and
+  // returns the node handle of the label, e.g., to push it into
+  // generic_tentative.  The label leaves the columns, and the last
+  // label of the key takes its place.  We look the label up in the
+  // columns in linear time, but the search does not take labels back.
+  node_type
+  extract(typename value_type::const_iterator i)
+  {
+    const auto &ti = get_key(*i);
+
+    if constexpr (columnar)
+      {
+        auto &sl = m_slots[ti];
+        std::size_t k = std::find(sl.m_ls.begin(), sl.m_ls.end(), &*i) -
+          sl.m_ls.begin();
+        assert(k < sl.m_ls.size());
+        auto last = sl.m_ls.size() - 1;
+        if (k != last)
+          {
+            sl.m_c.move(last, k);
+            sl.m_ls[k] = sl.m_ls[last];
+          }
+        sl.m_c.pop_back();
+        sl.m_ls.pop_back();
+      }
+
+    return base::operator[](ti).extract(i);
+  }
+
+private:
+  // Label l enters the columns of its key.
+  void
+  add_slot(const label_type &l)
+  {
+    if constexpr (columnar)
+      {
+        auto &sl = m_slots[get_key(l)];
+        sl.m_c.push_back(l);
+        sl.m_ls.push_back(&l);
+      }
+  }
 };
 
-/**
- * Is there in P a label that is better than or equal to label j?
- */
-template <typename Label>
+// Is there in c a label that is better than or equal to label j?
+// This is the counterpart of boe for containers of labels that are
+// sorted with generic_permanent2_cmp, and not with <.
+template <typename C, typename Label>
 bool
-has_better_or_equal(const generic_permanent2<Label> &P,
-                    const Label &j)
+boe2(const C &c, const Label &j)
 {
   // We have to iterate from the beginning and cannot use lower_bound
   // or upper_bound because the resources of the first label can
   // include the resources of j.
-  for (const auto &i: P[get_key(j)])
+  for (const auto &i: c)
     {
       // We can break the loop once we know that Callable()(j, i)
       // holds.  It holds in two cases:
@@ -134,4 +269,27 @@ has_better_or_equal(const generic_permanent2<Label> &P,
   return false;
 }
 
+/**
+ * Is there in P a label that is better than or equal to label j?
+ */
+template <typename Label>
+bool
+has_better_or_equal(const generic_permanent2<Label> &P,
+                    const Label &j)
+{
+  if constexpr (generic_permanent2<Label>::columnar)
+    {
+      // The columns are not sorted, so we compare j with all labels of
+      // the key, but in batches.
+      const auto &sl = P.m_slots[get_key(j)];
+      return boe_any(sl.m_c, sl.m_c.size(), j,
+                     [&sl](std::size_t i) -> const Label &
+                     {
+                       return *sl.m_ls[i];
+                     });
+    }
+  else
+    return boe2(P[get_key(j)], j);
+}
+
 #endif // GENERIC_PERMANENT2_HPP
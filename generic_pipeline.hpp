@@ -0,0 +1,143 @@
+#ifndef GENERIC_PIPELINE_HPP
+#define GENERIC_PIPELINE_HPP
+
+#include "generic_edge_summary.hpp"
+#include "generic_label.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+// The functor of the search composed at compile time from the label
+// creator and stages, e.g.:
+//
+//   creator<label> | width_filter<4> | weight_cap(100u)
+//
+// The functor computes the candidate weight and resources in place,
+// passes them through the stages in order, and produces the candidate
+// label as Label({w, r}, e), unless the resources are empty or a stage
+// rejects the candidate.  The stages are members of the functor, and
+// not behind pointers, and so the whole functor can be inlined.  The
+// functor returns a range, as the functors of the search do, and so
+// it can be used in generic_path_range too.
+//
+// A stage is called as s(l, e, w, r) with the label l, the edge e,
+// and the weight w and resources r of the candidate.  It returns false
+// to reject the candidate, and it can change w and r.
+
+// The candidate labels of a relaxation: none or one.
+template <typename Label>
+struct pipeline_candidates
+{
+  std::optional<Label> m_l;
+
+  Label *
+  begin()
+  {
+    return m_l ? &*m_l : nullptr;
+  }
+
+  Label *
+  end()
+  {
+    return m_l ? &*m_l + 1 : nullptr;
+  }
+};
+
+template <typename Label, typename... Stages>
+struct label_pipeline
+{
+  std::tuple<Stages...> m_stages;
+
+  template <typename Edge>
+  pipeline_candidates<Label>
+  operator()(const Label &l, const Edge &e) const
+  {
+    auto w = get_weight(l) + get_weight(e);
+    auto r = intersection(get_resources(l), get_resources(e));
+
+    if (r.empty())
+      return {};
+
+    // The stages in order, until one rejects the candidate.
+    bool admitted = std::apply([&](const auto &... s)
+    {
+      return (s(l, e, w, r) && ...);
+    }, m_stages);
+
+    if (!admitted)
+      return {};
+
+    return {Label({std::move(w), std::move(r)}, e)};
+  }
+};
+
+// Appends stage s to pipeline p.
+template <typename Label, typename... Stages, typename Stage>
+label_pipeline<Label, Stages..., Stage>
+operator | (label_pipeline<Label, Stages...> p, Stage s)
+{
+  return {std::tuple_cat(std::move(p.m_stages),
+                         std::make_tuple(std::move(s)))};
+}
+
+// The pipeline with no stages: the label creator.
+template <typename Label>
+inline constexpr label_pipeline<Label> creator{};
+
+// Rejects the candidate if its resources cannot fit Width units.
+template <unsigned Width>
+struct width_filter_stage
+{
+  template <typename Label, typename Edge, typename Weight,
+            typename Resources>
+  bool
+  operator()(const Label &, const Edge &, const Weight &,
+             const Resources &r) const
+  {
+    return largest_run(r) >= Width;
+  }
+};
+
+template <unsigned Width>
+inline constexpr width_filter_stage<Width> width_filter{};
+
+// Rejects the candidate if its weight is not better than or equal to
+// the cap.
+template <typename Weight>
+struct weight_cap
+{
+  Weight m_cap;
+
+  weight_cap(Weight cap): m_cap(std::move(cap))
+  {
+  }
+
+  template <typename Label, typename Edge, typename Resources>
+  bool
+  operator()(const Label &, const Edge &, const Weight &w,
+             const Resources &) const
+  {
+    return weight_boe(w, m_cap);
+  }
+};
+
+// Counts the candidates that reach the stage, and rejects none.  The
+// count is kept outside, since the functor is passed as const.
+struct candidate_counter
+{
+  std::size_t *m_count;
+
+  template <typename Label, typename Edge, typename Weight,
+            typename Resources>
+  bool
+  operator()(const Label &, const Edge &, const Weight &,
+             const Resources &) const
+  {
+    ++*m_count;
+    return true;
+  }
+};
+
+#endif // GENERIC_PIPELINE_HPP
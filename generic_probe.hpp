@@ -0,0 +1,76 @@
+#ifndef GENERIC_PROBE_HPP
+#define GENERIC_PROBE_HPP
+
+#include <cstddef>
+
+// The probe is told by the search what it does, so that we can look
+// at the cost of a search.  The probe that does nothing is the
+// default, and its functions are empty, and so the compiler drops the
+// calls.  See generic_telemetry.hpp for a probe that records.
+//
+// A probe can also have function bool stop(const P &, const T &),
+// which the search calls after a label became permanent, and stops
+// if it returns true.  See generic_footprint.hpp for a probe that
+// stops.
+//
+// A probe can also have function yielded(const Path &), which the
+// search calls when it yields a label of the target, with the
+// generic_path_range of the label.  The null probe does not have it,
+// and neither do the probes derived from it that do not add it, so
+// that the search does not go through the path for them: for many
+// sources, the search has to go through the path to find its source.
+struct null_probe
+{
+  // The search starts.
+  void
+  start()
+  {
+  }
+
+  // A label became permanent, and the tentative labels have the
+  // given number of labels.
+  void
+  popped(std::size_t)
+  {
+  }
+
+  // A candidate label was pushed into the tentative labels.
+  void
+  pushed()
+  {
+  }
+
+  // A candidate label was checked with has_better_or_equal of the
+  // permanent or the tentative labels.
+  void
+  dominance_checked()
+  {
+  }
+
+  // The search finished, or was abandoned by the caller.
+  void
+  finish()
+  {
+  }
+};
+
+// Calls start of the probe when constructed, and finish when
+// destroyed, so that the probe finishes even if the caller abandons
+// the search.
+template <typename Probe>
+struct probe_scope
+{
+  Probe &m_p;
+
+  probe_scope(Probe &p): m_p(p)
+  {
+    m_p.start();
+  }
+
+  ~probe_scope()
+  {
+    m_p.finish();
+  }
+};
+
+#endif // GENERIC_PROBE_HPP
@@ -0,0 +1,190 @@
+#ifndef GENERIC_RENUMBERING_HPP
+#define GENERIC_RENUMBERING_HPP
+
+#include "generic_path_range.hpp"
+#include "graph_interface.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+// The containers of labels are vectors indexed with the keys of
+// vertexes, and so the labels of the neighbours of a vertex can be
+// far apart in memory.  A renumbering gives the vertexes new keys, so
+// that the neighbours get close keys, and the search touches fewer
+// cache lines.
+//
+// The graph has to be built with the new keys (see renumber_edges),
+// and the search runs on that graph, so that its results are for the
+// new keys: the labels of the original key k are P[r.to_new(k)], and
+// the paths are those of generic_path_range for P, as for any search.
+// The renumbering translates the keys both ways, and renumbered_path
+// gives the original keys of the vertexes of a path.
+//
+// The orders need the neighbours of a vertex: function neighbours(v)
+// returns a range of the keys of the neighbours of vertex v.
+struct vertex_renumbering
+{
+  // The new key of the original key i.
+  std::vector<std::size_t> m_new;
+  // The original key of the new key i.
+  std::vector<std::size_t> m_old;
+
+  // Makes the renumbering of the given order, i.e., the original keys
+  // in the order of the new keys.
+  vertex_renumbering(std::vector<std::size_t> order):
+    m_new(order.size()), m_old(std::move(order))
+  {
+    for(std::size_t i = 0; i < m_old.size(); ++i)
+      {
+        assert(m_old[i] < m_new.size());
+        m_new[m_old[i]] = i;
+      }
+  }
+
+  std::size_t
+  size() const
+  {
+    return m_old.size();
+  }
+
+  std::size_t
+  to_new(std::size_t i) const
+  {
+    return m_new[i];
+  }
+
+  std::size_t
+  to_old(std::size_t i) const
+  {
+    return m_old[i];
+  }
+};
+
+// The vertexes in the order of the breadth-first search, started
+// from vertex 0 and then from the first vertex not visited yet, if the
+// graph is disconnected.
+template <typename Neighbours>
+vertex_renumbering
+bfs_renumbering(std::size_t count, Neighbours neighbours)
+{
+  std::vector<std::size_t> order;
+  order.reserve(count);
+  std::vector<bool> visited(count);
+
+  for(std::size_t s = 0; s < count; ++s)
+    if (!visited[s])
+      {
+        visited[s] = true;
+        order.push_back(s);
+
+        // The order is also the queue: the vertexes in [head, end).
+        for(std::size_t head = order.size() - 1; head < order.size();
+            ++head)
+          for(auto n: neighbours(order[head]))
+            if (!visited[n])
+              {
+                visited[n] = true;
+                order.push_back(n);
+              }
+      }
+
+  return vertex_renumbering(std::move(order));
+}
+
+// The reverse Cuthill-McKee order: the breadth-first search that
+// starts at a vertex of the smallest degree, visits the neighbours in
+// the order of increasing degree, and is reversed at the end.  It
+// keeps the keys of neighbours close: the largest difference of the
+// keys of neighbours (the bandwidth) is small.
+template <typename Neighbours>
+vertex_renumbering
+rcm_renumbering(std::size_t count, Neighbours neighbours)
+{
+  std::vector<std::size_t> degree(count);
+  for(std::size_t v = 0; v < count; ++v)
+    for([[maybe_unused]] auto n: neighbours(v))
+      ++degree[v];
+
+  // The vertexes sorted by degree, to find the start vertexes.
+  std::vector<std::size_t> by_degree(count);
+  std::iota(by_degree.begin(), by_degree.end(), 0);
+  std::ranges::stable_sort(by_degree, {},
+                           [&](auto v){return degree[v];});
+
+  std::vector<std::size_t> order;
+  order.reserve(count);
+  std::vector<bool> visited(count);
+  std::vector<std::size_t> next;
+
+  for(auto s: by_degree)
+    if (!visited[s])
+      {
+        visited[s] = true;
+        order.push_back(s);
+
+        for(std::size_t head = order.size() - 1; head < order.size();
+            ++head)
+          {
+            next.clear();
+            for(auto n: neighbours(order[head]))
+              if (!visited[n])
+                {
+                  visited[n] = true;
+                  next.push_back(n);
+                }
+
+            std::ranges::stable_sort(next, {},
+                                     [&](auto v){return degree[v];});
+            order.insert(order.end(), next.begin(), next.end());
+          }
+      }
+
+  std::ranges::reverse(order);
+
+  return vertex_renumbering(std::move(order));
+}
+
+// Builds the graph g renumbered with r: for every edge e of g, calls
+// add(s, t, e) to add the edge of the properties of e from the vertex
+// of the new key s to the vertex of the new key t.  The edges are
+// added in the order of the new keys of their sources, and so the
+// graph can be built as it goes.  The vertexes of g are looked up
+// with the original keys: g[k].
+template <typename Graph, typename Add>
+void
+renumber_edges(const Graph &g, const vertex_renumbering &r, Add add)
+{
+  assert(std::size(g) == r.size());
+
+  for(std::size_t i = 0; i < r.size(); ++i)
+    for(const auto &e: get_edges(g[r.to_old(i)]))
+      add(i, r.to_new(get_key(get_target(e))), e);
+}
+
+// The original keys of the vertexes of the path of label l, from the
+// source to the target, for the search on the graph renumbered with
+// r.  The path is that of generic_path_range(P, f, l, initial).
+template <typename Permanent, typename Functor>
+std::vector<std::size_t>
+renumbered_path(const vertex_renumbering &r, const Permanent &P,
+                const Functor &f, const typename Permanent::label_type &l,
+                const typename Permanent::label_type &initial)
+{
+  std::vector<std::size_t> keys;
+
+  // The path goes from the target to the source.
+  for(const auto &pl: generic_path_range(P, f, l, initial))
+    keys.push_back(r.to_old(get_key(get_target(get_edge(pl)))));
+  // The initial label is of the loop edge at the source.
+  keys.push_back(r.to_old(get_key(get_target(get_edge(initial)))));
+  std::ranges::reverse(keys);
+
+  return keys;
+}
+
+#endif // GENERIC_RENUMBERING_HPP
@@ -0,0 +1,235 @@
+#ifndef GENERIC_SEARCH_HPP
+#define GENERIC_SEARCH_HPP
+
+#include "generic_path_range.hpp"
+#include "generic_probe.hpp"
+#include "graph_interface.hpp"
+
+#include <algorithm>
+#include <generator>
+#include <utility>
+#include <vector>
+
+// The target of the search: one vertex.
+template <typename Key>
+struct search_target
+{
+  Key m_key;
+
+  // The labels of the target do not prune the labels of the other
+  // vertexes.
+  static constexpr bool combined = false;
+
+  template <typename K>
+  bool
+  contains(const K &k) const
+  {
+    return k == m_key;
+  }
+};
+
+// The targets of the search: any of the vertexes, e.g., of the data
+// centres of an anycast demand.  The yielded labels are the
+// boe-incomparable labels of all targets together: a label of a
+// target is not yielded if a label of another target is better than
+// or equal to it.  The yielded labels also prune the labels of the
+// other vertexes, because their paths to any target would be worse
+// than or equal to them.
+template <typename Key>
+struct search_targets
+{
+  // Sorted.
+  std::vector<Key> m_keys;
+
+  static constexpr bool combined = true;
+
+  search_targets(std::vector<Key> keys): m_keys(std::move(keys))
+  {
+    std::ranges::sort(m_keys);
+  }
+
+  template <typename K>
+  bool
+  contains(const K &k) const
+  {
+    return std::ranges::binary_search(m_keys, k);
+  }
+};
+
+// The functor of the relaxations of label l, i.e., that takes an edge,
+// and produces the candidate labels of l and the edge.  Functor f can
+// compute what it needs of l once, and not for every edge: then it
+// has function for_label(l) that returns such a functor.
+template <typename Functor, typename Label>
+auto
+label_functor(const Functor &f, const Label &l)
+{
+  if constexpr (requires {f.for_label(l);})
+    return f.for_label(l);
+  else
+    return [&f, &l](const auto &e)
+    {
+      return f(l, e);
+    };
+}
+
+// The search of generic Dijkstra as a lazy range of the labels of the
+// targets, which starts at many sources at once.  There is an initial
+// label for every source, i.e., the label of the loop edge at the
+// source.  The targets are search_target or search_targets.
+//
+// A path starts with one of the initial labels: to get the path of a
+// yielded label l, use generic_path_range(P, f, l, initials[i]) for i
+// = generic_path_source(P, f, l, initials).
+//
+// See generic_search for the rest.
+template <typename Permanent, typename Tentative, typename Functor,
+          typename Targets, typename Probe = null_probe>
+std::generator<const typename Permanent::label_type &>
+generic_multi_search(Permanent &P, Tentative &T, Functor f,
+                     std::vector<typename Permanent::label_type> initials,
+                     Targets targets, Probe probe = {})
+{
+  probe_scope<Probe> scope(probe);
+
+  // The candidate labels of a permanent label, if T takes them at
+  // once.  We keep the vector to reuse its memory.
+  std::vector<typename Permanent::label_type> batch;
+
+  // The yielded labels, sorted with <, since they are yielded in the
+  // order of <, for the combined targets.
+  std::vector<typename Permanent::label_type> front;
+
+  // The initial labels of the same source can be better than or
+  // equal to one another.
+  for(const auto &i: initials)
+    if (!has_better_or_equal(T, i))
+      T.push(i);
+
+  while(true)
+    {
+      // The lazy tentative labels drop the dominated labels here.
+      if constexpr (requires {T.purge(P);})
+        T.purge(P);
+
+      if (T.empty())
+        break;
+
+      // The label that becomes permanent.
+      const auto &l = P.push(T.pop());
+
+      // We report no tentative labels if we cannot count them.
+      if constexpr (requires {T.label_count();})
+        probe.popped(T.label_count());
+      else
+        probe.popped(0);
+
+      // The probe can stop the search, e.g., when the labels take too
+      // much memory.
+      if constexpr (requires {probe.stop(P, T);})
+        if (probe.stop(P, T))
+          break;
+
+      // The vertex of the label.
+      const auto &v = get_target(get_edge(l));
+
+      // We do not go past a target vertex, because the labels we
+      // would produce there would lead back to the target, or to
+      // another target, and so they would be worse than or equal to
+      // label l.
+      if (targets.contains(get_key(v)))
+        {
+          if constexpr (Targets::combined)
+            {
+              if (boe(front, l))
+                continue;
+              front.push_back(l);
+            }
+
+          // We go through the path only for the probe that looks at
+          // it: for many sources we would have to go through the path
+          // to find its source.
+          if constexpr (requires {probe.yielded(generic_path_range
+                                                (P, f, l, initials[0]));})
+            {
+              auto i = initials.size() == 1 ? 0 :
+                generic_path_source(P, f, l, initials);
+              probe.yielded(generic_path_range(P, f, l, initials[i]));
+            }
+          co_yield l;
+          continue;
+        }
+
+      const auto fl = label_functor(f, l);
+      for(const auto &e: get_edges(v))
+        for(auto &&c: fl(e))
+          {
+            if constexpr (Targets::combined)
+              if (boe(front, c))
+                continue;
+
+            probe.dominance_checked();
+            if (has_better_or_equal(P, c))
+              continue;
+
+            // T compares the candidates with its labels by itself.
+            if constexpr (requires {T.push_batch(batch);})
+              batch.push_back(std::move(c));
+            else
+              {
+                // A lazy T (generic_lazy_tentative) always says no, and
+                // drops the label later, if it is dominated.
+                probe.dominance_checked();
+                if (has_better_or_equal(T, c))
+                  continue;
+
+                probe.pushed();
+                T.push(std::move(c));
+              }
+          }
+
+      // As for the candidates pushed one by one, T checks every
+      // candidate, and we count the candidates T takes.
+      if constexpr (requires {T.push_batch(batch);})
+        {
+          for([[maybe_unused]] const auto &c: batch)
+            probe.dominance_checked();
+          for(auto n = T.push_batch(batch); n; --n)
+            probe.pushed();
+        }
+    }
+}
+
+// The search of generic Dijkstra as a lazy range of the labels of the
+// target vertex.  A label is yielded as soon as it becomes permanent,
+// and the search goes on only when the next label is requested, so
+// the caller can stop at any time without paying for the rest of the
+// search.  The labels are yielded in the order of <, i.e., the first
+// label is of the shortest path.
+//
+// The search starts with the initial label, i.e., the label of the
+// loop edge at the source vertex.  Functor f produces the candidate
+// labels for a label and an edge (a range of none, one or more
+// labels), as required by generic_path_range.  To get the path of a
+// yielded label l, use generic_path_range(P, f, l, initial).
+//
+// The containers are the caller's, so that the caller can look at
+// them during and after the search.  A yielded reference is valid as
+// long as the label stays in P, which for generic_permanent is until
+// the search is resumed, and for generic_permanent2 is for good.
+//
+// We take the functor, the initial label, the key of the target, and
+// the probe by value, because the search runs after this function
+// returns.  The probe is told about the search: see generic_probe.hpp.
+template <typename Permanent, typename Tentative, typename Functor,
+          typename Key, typename Probe = null_probe>
+std::generator<const typename Permanent::label_type &>
+generic_search(Permanent &P, Tentative &T, Functor f,
+               typename Permanent::label_type initial, Key dst,
+               Probe probe = {})
+{
+  return generic_multi_search(P, T, std::move(f), {std::move(initial)},
+                              search_target<Key>{dst}, std::move(probe));
+}
+
+#endif // GENERIC_SEARCH_HPP
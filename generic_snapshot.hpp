@@ -0,0 +1,318 @@
+#ifndef GENERIC_SNAPSHOT_HPP
+#define GENERIC_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A snapshot stores the permanent labels of a search in a binary
+// file, so that we do not have to repeat the search after a restart.
+// The file can be mapped into memory, and used in place: a key is
+// looked up in constant time, and the labels are not copied.
+//
+// A label refers to its edge, usually with a pointer, which is
+// meaningless in another process, and so we store records instead of
+// labels.  A record is a trivially-copyable value that the caller
+// produces from a label (e.g., the weight, the resources, and the
+// index of the edge), and turns back into a label when loading.
+//
+// The file is laid out as follows:
+//
+// * the header,
+//
+// * the offsets: for every key i, the labels of key i are the records
+//   in [offsets[i], offsets[i + 1]),
+//
+// * the records.
+//
+// The header, and the offsets are a multiple of 8 bytes long, and so
+// the records are aligned in a mapped file for the records of
+// alignment at most 8.  The numbers are stored in the byte order of
+// the machine, and the file of a machine of the other order is
+// rejected as of the wrong version.
+//
+// The header has the fingerprint of the state (the graph and the
+// state of its edges) that the labels were found for.  A snapshot is
+// rejected if the fingerprint is different, since the labels are
+// then stale.
+
+// The header of a snapshot file.
+struct snapshot_header
+{
+  char m_magic[8];
+  // The version of the format, which also tells the byte order.
+  std::uint32_t m_version;
+  // The size of a record, so that we do not read records of some
+  // other type.
+  std::uint32_t m_record_size;
+  // The fingerprint of the state.
+  std::uint64_t m_fingerprint;
+  // The number of keys.
+  std::uint64_t m_keys;
+  // The number of records.
+  std::uint64_t m_records;
+};
+
+static_assert(sizeof(snapshot_header) % 8 == 0);
+
+inline constexpr char snapshot_magic[8] = {'G', 'D', 'S', 'N', 'A', 'P',
+                                           '\0', '\0'};
+inline constexpr std::uint32_t snapshot_version = 1;
+
+// The FNV-1a hash of the state.  Add the values that matter for the
+// labels (the number of vertexes, and the weight, the resources, and
+// the end vertexes of every edge) in a fixed order.
+struct snapshot_fingerprint
+{
+  std::uint64_t m_h = 0xcbf29ce484222325;
+
+  template <typename T> requires std::is_trivially_copyable_v<T>
+  snapshot_fingerprint &
+  add(const T &t)
+  {
+    unsigned char b[sizeof(T)];
+    std::memcpy(b, &t, sizeof(T));
+
+    for(auto c: b)
+      {
+        m_h ^= c;
+        m_h *= 0x100000001b3;
+      }
+
+    return *this;
+  }
+
+  std::uint64_t
+  value() const
+  {
+    return m_h;
+  }
+};
+
+template <typename Record>
+concept snapshot_record = std::is_trivially_copyable_v<Record> &&
+  alignof(Record) <= 8;
+
+// Writes the labels of P as the records produced by function encode.
+template <typename Permanent, typename Encode>
+void
+save_snapshot(std::ostream &out, const Permanent &P, Encode encode,
+              std::uint64_t fingerprint)
+{
+  using record_type = std::remove_cvref_t<
+    decltype(encode(std::declval<const typename Permanent::label_type &>()))>;
+  static_assert(snapshot_record<record_type>);
+
+  std::vector<std::uint64_t> offsets;
+  offsets.reserve(P.size() + 1);
+  offsets.push_back(0);
+  for(const auto &vd: P)
+    offsets.push_back(offsets.back() + vd.size());
+
+  snapshot_header h{};
+  std::memcpy(h.m_magic, snapshot_magic, sizeof(h.m_magic));
+  h.m_version = snapshot_version;
+  h.m_record_size = sizeof(record_type);
+  h.m_fingerprint = fingerprint;
+  h.m_keys = P.size();
+  h.m_records = offsets.back();
+
+  out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+  out.write(reinterpret_cast<const char *>(offsets.data()),
+            offsets.size() * sizeof(std::uint64_t));
+
+  // We write the records of a key at once.
+  std::vector<record_type> records;
+  for(const auto &vd: P)
+    {
+      records.clear();
+      for(const auto &l: vd)
+        records.push_back(encode(l));
+      out.write(reinterpret_cast<const char *>(records.data()),
+                records.size() * sizeof(record_type));
+    }
+
+  if (!out)
+    throw std::runtime_error("snapshot: cannot write");
+}
+
+// The records of a snapshot in memory, e.g., in a mapped file.  The
+// view does not own the memory.
+//
+// The view is a container of permanent labels as far as
+// generic_path_range is concerned: the labels of a key are
+// view[key].  The records can be used as labels in place if get_key,
+// get_edge and == are defined for them, and the functor produces
+// records.
+template <snapshot_record Record>
+struct generic_snapshot_view
+{
+  // The label type.
+  using label_type = Record;
+  // The size type.
+  using size_type = std::size_t;
+
+  const std::uint64_t *m_offsets = nullptr;
+  const Record *m_records = nullptr;
+  size_type m_keys = 0;
+
+  generic_snapshot_view() = default;
+
+  // Checks that the memory holds a snapshot of records of type Record
+  // for the state of the given fingerprint.  The memory must be
+  // aligned to 8 bytes, as a mapped file is.
+  generic_snapshot_view(std::span<const std::byte> s,
+                        std::uint64_t fingerprint)
+  {
+    snapshot_header h;
+
+    if (s.size() < sizeof(h))
+      throw std::runtime_error("snapshot: too short");
+
+    std::memcpy(&h, s.data(), sizeof(h));
+
+    if (std::memcmp(h.m_magic, snapshot_magic, sizeof(h.m_magic)))
+      throw std::runtime_error("snapshot: not a snapshot");
+    if (h.m_version != snapshot_version)
+      throw std::runtime_error("snapshot: wrong version");
+    if (h.m_record_size != sizeof(Record))
+      throw std::runtime_error("snapshot: wrong record size");
+    if (h.m_fingerprint != fingerprint)
+      throw std::runtime_error("snapshot: stale");
+
+    // The numbers come from the file, and so we bound them by the size
+    // before we multiply them, so that the sizes do not overflow.
+    std::size_t rest = s.size() - sizeof(h);
+    if (h.m_keys >= rest / sizeof(std::uint64_t))
+      throw std::runtime_error("snapshot: wrong size");
+    std::size_t o_size = (h.m_keys + 1) * sizeof(std::uint64_t);
+    rest -= o_size;
+    if (h.m_records > rest / sizeof(Record))
+      throw std::runtime_error("snapshot: wrong size");
+    std::size_t r_size = h.m_records * sizeof(Record);
+    if (rest != r_size)
+      throw std::runtime_error("snapshot: wrong size");
+
+    if (reinterpret_cast<std::uintptr_t>(s.data()) % 8)
+      throw std::runtime_error("snapshot: misaligned");
+
+    m_offsets = reinterpret_cast<const std::uint64_t *>
+      (s.data() + sizeof(h));
+    m_records = reinterpret_cast<const Record *>
+      (s.data() + sizeof(h) + o_size);
+    m_keys = h.m_keys;
+
+    // The offsets must not decrease, and must end with the number of
+    // records, so that we can use them without checking.
+    if (m_offsets[0] != 0 || m_offsets[m_keys] != h.m_records)
+      throw std::runtime_error("snapshot: corrupt offsets");
+    for(size_type i = 0; i < m_keys; ++i)
+      if (m_offsets[i] > m_offsets[i + 1])
+        throw std::runtime_error("snapshot: corrupt offsets");
+  }
+
+  size_type
+  size() const
+  {
+    return m_keys;
+  }
+
+  // The records of key i.
+  std::span<const Record>
+  operator[](size_type i) const
+  {
+    return {m_records + m_offsets[i], m_records + m_offsets[i + 1]};
+  }
+};
+
+// A file mapped read-only into memory.
+struct snapshot_mapping
+{
+  void *m_data = nullptr;
+  std::size_t m_size = 0;
+
+  snapshot_mapping(const std::string &path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("snapshot: cannot open " + path);
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0)
+      {
+        ::close(fd);
+        throw std::runtime_error("snapshot: cannot stat " + path);
+      }
+
+    m_size = st.st_size;
+
+    // We cannot map an empty file, and we leave it to the view to
+    // reject it.
+    if (m_size)
+      {
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m_data == MAP_FAILED)
+          {
+            m_data = nullptr;
+            ::close(fd);
+            throw std::runtime_error("snapshot: cannot map " + path);
+          }
+      }
+
+    // The mapping stays after we close the file.
+    ::close(fd);
+  }
+
+  snapshot_mapping(const snapshot_mapping &) = delete;
+  snapshot_mapping &operator = (const snapshot_mapping &) = delete;
+
+  snapshot_mapping(snapshot_mapping &&m) noexcept:
+    m_data(std::exchange(m.m_data, nullptr)),
+    m_size(std::exchange(m.m_size, 0))
+  {
+  }
+
+  ~snapshot_mapping()
+  {
+    if (m_data)
+      ::munmap(m_data, m_size);
+  }
+
+  std::span<const std::byte>
+  bytes() const
+  {
+    return {static_cast<const std::byte *>(m_data), m_size};
+  }
+};
+
+// Loads the records of view v into P, turning them into labels with
+// function decode.  The labels of a key are allocated at once, and so
+// there is one allocation per key at most, and none per label.  P
+// takes the labels of a key with assign, so that it keeps up what it
+// has for them, e.g., the columns of generic_permanent.
+template <typename Permanent, typename Record, typename Decode>
+void
+load_snapshot(Permanent &P, const generic_snapshot_view<Record> &v,
+              Decode decode)
+{
+  if (P.size() != v.size())
+    throw std::runtime_error("snapshot: wrong number of keys");
+
+  for(std::size_t i = 0; i < v.size(); ++i)
+    P.assign(i, v[i] | std::views::transform(decode));
+}
+
+#endif // GENERIC_SNAPSHOT_HPP
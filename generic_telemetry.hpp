@@ -0,0 +1,299 @@
+#ifndef GENERIC_TELEMETRY_HPP
+#define GENERIC_TELEMETRY_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// The telemetry of searches: a probe for generic_search that writes a
+// record of every search into the ring buffer of its thread, and the
+// functions that read the records of all threads, and dump them.
+//
+// A thread only writes to its ring, and so writing takes no lock.
+// The ring keeps the latest records, and the older ones are
+// overwritten.  A reader can read the rings at any time: the records
+// being overwritten while read are dropped.
+
+// The record of a search.  All fields are 64-bit numbers, so that we
+// can store them in atomics.
+struct search_record
+{
+  // The wall time from the start to the end of the search, including
+  // the time the caller spent between the labels.
+  std::uint64_t m_time_ns = 0;
+  // The number of labels that became permanent.
+  std::uint64_t m_popped = 0;
+  // The number of labels pushed into the tentative labels.
+  std::uint64_t m_pushed = 0;
+  // The largest number of the tentative labels.
+  std::uint64_t m_peak_tentative = 0;
+  // The number of the dominance checks of the candidate labels, i.e.,
+  // of the calls to has_better_or_equal of a container, not of the
+  // calls to boe, of which a check makes any number.
+  std::uint64_t m_dominance_checks = 0;
+  // The number of labels of the target.
+  std::uint64_t m_labels = 0;
+  // The number of edges of the path of the first label of the
+  // target, or 0 if there is none.
+  std::uint64_t m_hops = 0;
+};
+
+// The names of the fields, for the dumps.
+inline constexpr const char *search_record_names[] =
+  {"time_ns", "popped", "pushed", "peak_tentative", "dominance_checks",
+   "labels", "hops"};
+
+inline constexpr std::size_t search_record_size =
+  sizeof(search_record) / sizeof(std::uint64_t);
+
+static_assert(std::size(search_record_names) == search_record_size);
+
+// The ring buffer of the records of a thread.  There is one writer
+// (the thread), and any number of readers.
+struct telemetry_ring
+{
+  static constexpr std::size_t capacity = 1024;
+
+  // A slot has a sequence number, which is odd while the slot is
+  // written, and the fields of a record.
+  struct slot
+  {
+    std::atomic<std::uint64_t> m_seq = 0;
+    std::array<std::atomic<std::uint64_t>, search_record_size> m_fields;
+  };
+
+  std::array<slot, capacity> m_slots;
+  // The number of the records written.
+  std::atomic<std::uint64_t> m_head = 0;
+
+  void
+  write(const search_record &r)
+  {
+    auto fields =
+      std::bit_cast<std::array<std::uint64_t, search_record_size>>(r);
+
+    auto h = m_head.load(std::memory_order_relaxed);
+    auto &s = m_slots[h % capacity];
+    auto seq = s.m_seq.load(std::memory_order_relaxed);
+
+    s.m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(std::size_t i = 0; i < search_record_size; ++i)
+      s.m_fields[i].store(fields[i], std::memory_order_relaxed);
+    s.m_seq.store(seq + 2, std::memory_order_release);
+
+    m_head.store(h + 1, std::memory_order_release);
+  }
+
+  // Appends the records to rs, from the oldest to the latest.
+  void
+  read(std::vector<search_record> &rs) const
+  {
+    auto h = m_head.load(std::memory_order_acquire);
+    auto b = h > capacity ? h - capacity : 0;
+
+    for(auto i = b; i < h; ++i)
+      {
+        const auto &s = m_slots[i % capacity];
+        std::array<std::uint64_t, search_record_size> fields;
+
+        auto seq1 = s.m_seq.load(std::memory_order_acquire);
+        for(std::size_t j = 0; j < search_record_size; ++j)
+          fields[j] = s.m_fields[j].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto seq2 = s.m_seq.load(std::memory_order_relaxed);
+
+        // The slot was being written, or was written again after we
+        // took the head.
+        if (seq1 != seq2 || seq1 % 2 ||
+            m_head.load(std::memory_order_acquire) - i > capacity)
+          continue;
+
+        rs.push_back(std::bit_cast<search_record>(fields));
+      }
+  }
+};
+
+// The rings of all threads.  A ring outlives its thread, so that its
+// records can be read later.
+struct telemetry_registry
+{
+  std::mutex m_mutex;
+  std::vector<std::shared_ptr<telemetry_ring>> m_rings;
+
+  static telemetry_registry &
+  get()
+  {
+    static telemetry_registry r;
+    return r;
+  }
+
+  // The ring of the calling thread.  We take the lock only when a
+  // thread writes its first record.
+  static telemetry_ring &
+  local()
+  {
+    thread_local std::shared_ptr<telemetry_ring> ring = []
+    {
+      auto ring = std::make_shared<telemetry_ring>();
+      auto &r = get();
+      std::lock_guard lock(r.m_mutex);
+      r.m_rings.push_back(ring);
+      return ring;
+    }();
+
+    return *ring;
+  }
+
+  // The records of all threads.
+  std::vector<search_record>
+  collect()
+  {
+    std::vector<std::shared_ptr<telemetry_ring>> rings;
+    {
+      std::lock_guard lock(m_mutex);
+      rings = m_rings;
+    }
+
+    std::vector<search_record> rs;
+    for(const auto &ring: rings)
+      ring->read(rs);
+
+    return rs;
+  }
+};
+
+// The probe that records a search into the ring of its thread.
+struct telemetry_probe
+{
+  search_record m_r;
+  std::chrono::steady_clock::time_point m_t0;
+
+  void
+  start()
+  {
+    m_t0 = std::chrono::steady_clock::now();
+  }
+
+  void
+  popped(std::size_t tentative)
+  {
+    ++m_r.m_popped;
+    m_r.m_peak_tentative = std::max<std::uint64_t>(m_r.m_peak_tentative,
+                                                   tentative);
+  }
+
+  void
+  pushed()
+  {
+    ++m_r.m_pushed;
+  }
+
+  void
+  dominance_checked()
+  {
+    ++m_r.m_dominance_checks;
+  }
+
+  template <typename Path>
+  void
+  yielded(const Path &path)
+  {
+    if (!m_r.m_labels++)
+      for(auto i = path.begin(); !(i == path.end()); ++i)
+        ++m_r.m_hops;
+  }
+
+  void
+  finish()
+  {
+    auto t = std::chrono::steady_clock::now() - m_t0;
+    m_r.m_time_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+    telemetry_registry::local().write(m_r);
+  }
+};
+
+// Returns the field of record r by its index.
+inline std::uint64_t
+get_field(const search_record &r, std::size_t i)
+{
+  return std::bit_cast<std::array<std::uint64_t, search_record_size>>(r)[i];
+}
+
+// Writes the records as CSV, with a header.
+inline void
+write_csv(std::ostream &out, const std::vector<search_record> &rs)
+{
+  for(std::size_t i = 0; i < search_record_size; ++i)
+    out << (i ? "," : "") << search_record_names[i];
+  out << '\n';
+
+  for(const auto &r: rs)
+    {
+      for(std::size_t i = 0; i < search_record_size; ++i)
+        out << (i ? "," : "") << get_field(r, i);
+      out << '\n';
+    }
+}
+
+// Writes the records as a JSON array of objects.
+inline void
+write_json(std::ostream &out, const std::vector<search_record> &rs)
+{
+  out << '[';
+  for(std::size_t j = 0; j < rs.size(); ++j)
+    {
+      out << (j ? ",\n " : "") << '{';
+      for(std::size_t i = 0; i < search_record_size; ++i)
+        out << (i ? ", " : "") << '"' << search_record_names[i] << "\": "
+            << get_field(rs[j], i);
+      out << '}';
+    }
+  out << "]\n";
+}
+
+// The histogram of field i of the records: bin 0 counts the zeros,
+// and bin b > 0 counts the values in [2^(b - 1), 2^b).
+inline std::vector<std::size_t>
+histogram(const std::vector<search_record> &rs, std::size_t i)
+{
+  std::vector<std::size_t> h;
+
+  for(const auto &r: rs)
+    {
+      std::size_t b = std::bit_width(get_field(r, i));
+      if (b >= h.size())
+        h.resize(b + 1);
+      ++h[b];
+    }
+
+  return h;
+}
+
+// Writes the histogram as the lines of "[min, max): count".  Bin 64
+// has no max that fits in 64 bits, and so its max is "inf".
+inline void
+write_histogram(std::ostream &out, const std::vector<std::size_t> &h)
+{
+  for(std::size_t b = 0; b < h.size(); ++b)
+    {
+      std::uint64_t min = b ? std::uint64_t(1) << (b - 1) : 0;
+      out << '[' << min << ", ";
+      if (b < 64)
+        out << (std::uint64_t(1) << b);
+      else
+        out << "inf";
+      out << "): " << h[b] << '\n';
+    }
+}
+
+#endif // GENERIC_TELEMETRY_HPP
@@ -1,9 +1,16 @@
 #ifndef GENERIC_TENTATIVE_HPP
 #define GENERIC_TENTATIVE_HPP
 
+#include "generic_boe_batch.hpp"
+
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <set>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // The container type for storing the generic tentative labels.  The
@@ -21,6 +28,17 @@
 // For a given key, we store labels in a set because we do not allow a
 // vertex to have multiple labels that are equal. The order of the
 // labels is established by <.
+//
+// For the labels that the boe kernels compare (see
+// generic_boe_batch.hpp), we also keep the columns of the labels of
+// every key, so that has_better_or_equal and purge_worse_or_equal
+// compare a label with the labels of its key in batches.  The labels
+// are in the columns in no particular order, and we keep the
+// iterators to the labels in the order of the columns.  A label
+// leaves the columns when the last label of the key takes its place.
+// We also keep the slots of the labels in the columns by the addresses
+// of the labels, so that pop_node finds the slot of the label it pops
+// in constant time.
 template <typename Label>
 struct generic_tentative: std::vector<std::set<Label>>
 {
@@ -32,6 +50,8 @@ struct generic_tentative: std::vector<std::set<Label>>
   using base_type = std::vector<vd_type>;
   // The size type of the base type.
   using size_type = typename base_type::size_type;
+  // The node handle type of the vertex data.
+  using node_type = typename vd_type::node_type;
 
   // The functor structure for comparing the keys in the queue.  The
   // keys are sorted by the labels the keys refer to.  For a given
@@ -66,8 +86,31 @@ struct generic_tentative: std::vector<std::set<Label>>
   // is unique, because even if labels, the keys would differ.
   std::set<size_type, cmp> m_pq;
 
+  // The number of labels of all keys.  We cannot call it size,
+  // because that is the number of keys.
+  size_type m_label_count = 0;
+  // The most labels of all keys the container had at once: the
+  // high-water mark of m_label_count.
+  size_type m_peak_label_count = 0;
+
+  // Do we keep the columns?
+  static constexpr bool columnar = boe_columnar<Label>;
+
+  // The columns of the labels of a key, and the labels in that order.
+  struct slots_type
+  {
+    boe_columns<label_type> m_c;
+    std::vector<typename vd_type::const_iterator> m_its;
+  };
+
+  // The columns of every key, if columnar.
+  std::vector<slots_type> m_slots;
+  // The slot of every label in the columns of its key, if columnar.
+  std::unordered_map<const label_type *, std::size_t> m_slot_of;
+
   // The constructor builds a vector of data for each vertex.
-  generic_tentative(size_type count): base_type(count), m_pq(*this)
+  generic_tentative(size_type count):
+    base_type(count), m_pq(*this), m_slots(columnar ? count : 0)
   {
   }
 
@@ -76,6 +119,219 @@ struct generic_tentative: std::vector<std::set<Label>>
   template<typename T>
   const auto &
   push(T &&l)
+  {
+    return insert(l, [&l](vd_type &vd)
+    {
+      auto [i, s] = vd.insert(std::forward<T>(l));
+      // The insertion must have been successful.
+      assert(s);
+      return i;
+    });
+  }
+
+  // This function pushes the label held by node handle nh, and
+  // returns a reference to the label in the container.  The node is
+  // reused, so there is no allocation, and the label is not copied.
+  // The node handle can come from pop_node of this container, or
+  // from other containers of labels, e.g., from extract of
+  // generic_permanent2.
+  const auto &
+  push(node_type &&nh)
+  {
+    assert(!nh.empty());
+    // The label stays in the node, so the reference remains valid
+    // after the node is inserted.
+    const label_type &l = nh.value();
+
+    return insert(l, [&nh](vd_type &vd)
+    {
+      auto [i, s, n] = vd.insert(std::move(nh));
+      // The insertion must have been successful.
+      assert(s);
+      return i;
+    });
+  }
+
+  // This function pushes the labels of ls, e.g., the candidate labels
+  // of all edges of a label that became permanent, clears ls, and
+  // returns the number of the labels pushed.  Unlike push, it drops
+  // the labels for which there are better or equal labels, be it in
+  // this container or in ls, and so the caller should not call
+  // has_better_or_equal for them.
+  //
+  // We sort the labels by key, so that the labels of a key are
+  // compared with each other first, and then the set and the queue
+  // position of the key are updated once, and not for every label.
+  // The vertex data of the next key is prefetched while we work on
+  // the current one.
+  size_type
+  push_batch(std::vector<label_type> &ls)
+  {
+    std::ranges::sort(ls, {}, [](const auto &l){return get_key(l);});
+    size_type pushed = 0;
+
+    for(auto b = ls.begin(); b != ls.end();)
+      {
+        auto key = get_key(*b);
+        auto e = std::find_if(b, ls.end(), [key](const auto &l)
+        {
+          return get_key(l) != key;
+        });
+
+        // Most keys get a single label, and then there is nothing to
+        // sort.
+        if (e - b > 1)
+          std::sort(b, e);
+
+#if defined(__GNUC__)
+        if (e != ls.end())
+          __builtin_prefetch(&base_type::operator[](get_key(*e)));
+#endif
+
+        auto &vd = base_type::operator[](key);
+
+        // The labels in [b, k) are boe-incomparable, and have no better
+        // or equal labels in vd.  Since the labels are sorted with <,
+        // a label can be worse than or equal to the labels before it
+        // only.
+        auto k = b;
+        for(auto i = b; i != e; ++i)
+          if (!has_boe(key, *i) &&
+              std::none_of(b, k, [&i](const auto &j){return boe(j, *i);}))
+            {
+              if (k != i)
+                *k = std::move(*i);
+              ++k;
+            }
+
+        pushed += k - b;
+
+        if (b != k)
+          {
+            // As in insert, the key goes out of the queue while we
+            // change vd only if the first label of vd changes, i.e.,
+            // when the smallest label *b goes before it.  Otherwise,
+            // *b cannot purge the first label.
+            bool first = vd.empty() || *b < *vd.begin();
+            if (first && !vd.empty())
+              m_pq.erase(key);
+
+            m_label_count -= vd.size();
+            for(auto i = b; i != k; ++i)
+              {
+                purge_worse_or_equal(vd, *i);
+                [[maybe_unused]] auto [j, s] = vd.insert(std::move(*i));
+                assert(s);
+                add_slot(key, j);
+              }
+            m_label_count += vd.size();
+            m_peak_label_count = std::max(m_peak_label_count,
+                                          m_label_count);
+
+            if (first)
+              m_pq.insert(key);
+          }
+
+        b = e;
+      }
+
+    ls.clear();
+
+    return pushed;
+  }
+
+  // This function builds a new label in place from args (e.g., from
+  // the weight and resources produced by generic_label_creator),
+  // pushes it, and returns a reference to the label in the
+  // container.
+  template<typename... Args>
+  const auto &
+  emplace(Args &&...args)
+  {
+    return push(make_node(std::forward<Args>(args)...));
+  }
+
+  bool
+  empty() const
+  {
+    return m_pq.empty();
+  }
+
+  // The number of labels of all keys.
+  size_type
+  label_count() const
+  {
+    return m_label_count;
+  }
+
+  size_type
+  peak_label_count() const
+  {
+    return m_peak_label_count;
+  }
+
+  // Here we return a label by value.
+  auto
+  pop()
+  {
+    return std::move(pop_node().value());
+  }
+
+  // Here we return the node handle of the label, so that the node can
+  // be pushed into another container without reallocation.
+  node_type
+  pop_node()
+  {
+    assert(!m_pq.empty());
+    // Get the key from the queue.
+    size_type key = *m_pq.begin();
+    m_pq.erase(m_pq.begin());
+    // Get the set for the key.
+    auto &vd = base_type::operator[](key);
+    assert(!vd.empty());
+    // The first element leaves the columns.
+    if constexpr (columnar)
+      remove_slot(key, m_slot_of[&*vd.begin()]);
+    // Get the first element.
+    auto nh = vd.extract(vd.begin());
+    --m_label_count;
+    // Insert the key again if the set is not empty.
+    if (!vd.empty())
+      m_pq.insert(key);
+
+    // There are no labels in vd or the key is in m_pq.  If there are
+    // no labels, then we cannot make sure the key is not in the
+    // queue, because functor cmp would accces a label in an empty vd.
+    assert(vd.empty() || m_pq.contains(key));
+
+    return nh;
+  }
+
+  // Is there a label of the key that is better than or equal to j?
+  bool
+  has_boe(size_type key, const label_type &j) const
+  {
+    if constexpr (columnar)
+      {
+        const auto &sl = m_slots[key];
+        return boe_any(sl.m_c, sl.m_c.size(), j,
+                       [&sl](std::size_t i) -> const label_type &
+                       {
+                         return *sl.m_its[i];
+                       });
+      }
+    else
+      return boe(base_type::operator[](key), j);
+  }
+
+private:
+  // Inserts label l into the set for its key, and keeps the priority
+  // queue consistent.  Function inserter does the actual insertion
+  // into the set, after the worse or equal labels were purged, and
+  // returns the iterator to the inserted label.
+  template <typename Inserter>
+  const label_type &
+  insert(const label_type &l, Inserter inserter)
   {
     // The key of the label.
     auto key = get_key(l);
@@ -98,12 +354,14 @@ struct generic_tentative: std::vector<std::set<Label>>
     // to remove those labels now, before we insert l, because we're
     // removing the worse or equal labels, and so we would remove
     // label l too.
+    m_label_count -= vd.size();
     purge_worse_or_equal(vd, l);
 
     // Insert the new label to the set.
-    auto [i, s] = vd.insert(std::forward<T>(l));
-    // The insertion must have been successful.
-    assert(s);
+    auto i = inserter(vd);
+    m_label_count += vd.size();
+    m_peak_label_count = std::max(m_peak_label_count, m_label_count);
+    add_slot(key, i);
 
     // Insert the key to the priority queue only if the label ended up
     // at the beginning of the set, which can happen for one of two
@@ -128,43 +386,102 @@ struct generic_tentative: std::vector<std::set<Label>>
     return *i;
   }
 
-  bool
-  empty() const
+  // Builds a label from args in a node of its own.
+  template <typename... Args>
+  static node_type
+  make_node(Args &&...args)
   {
-    return m_pq.empty();
+    vd_type vd;
+    vd.emplace(std::forward<Args>(args)...);
+    return vd.extract(vd.begin());
   }
 
-  // Here we return a label by value.
-  auto
-  pop()
+  // Label i of the key enters the columns.
+  void
+  add_slot(size_type key, typename vd_type::const_iterator i)
   {
-    assert(!m_pq.empty());
-    // Get the key from the queue.
-    size_type key = *m_pq.begin();
-    m_pq.erase(m_pq.begin());
-    // Get the set for the key.
-    auto &vd = base_type::operator[](key);
-    assert(!vd.empty());
-    // Get the first element.
-    auto nh = vd.extract(vd.begin());
-    // Insert the key again if the set is not empty.
-    if (!vd.empty())
-      m_pq.insert(key);
-
-    // There are no labels in vd or the key is in m_pq.  If there are
-    // no labels, then we cannot make sure the key is not in the
-    // queue, because functor cmp would accces a label in an empty vd.
-    assert(vd.empty() || m_pq.contains(key));
+    if constexpr (columnar)
+      {
+        auto &sl = m_slots[key];
+        m_slot_of.emplace(&*i, sl.m_its.size());
+        sl.m_c.push_back(*i);
+        sl.m_its.push_back(i);
+      }
+  }
 
-    return std::move(nh.value());
+  // Label k of the columns of the key leaves them, and the last label
+  // takes its place.  Call it while the label is still in the set of
+  // the key, since we take its address.
+  void
+  remove_slot(size_type key, std::size_t k)
+  {
+    if constexpr (columnar)
+      {
+        auto &sl = m_slots[key];
+        assert(k < sl.m_its.size());
+        m_slot_of.erase(&*sl.m_its[k]);
+        auto last = sl.m_its.size() - 1;
+        if (k != last)
+          {
+            sl.m_c.move(last, k);
+            sl.m_its[k] = sl.m_its[last];
+            m_slot_of[&*sl.m_its[k]] = k;
+          }
+        sl.m_c.pop_back();
+        sl.m_its.pop_back();
+      }
   }
 
-private:
   // Purge from vd those labels i that are worse than or equal to j,
   // i.e., those for which boe(j, i) is true.
   void
   purge_worse_or_equal(vd_type &vd, const label_type &j)
   {
+    if constexpr (columnar)
+      {
+        // We go from the last batch to the first, and from the last
+        // label of a batch to the first, so that the last label that
+        // takes the place of a removed one was already looked at.
+        auto key = get_key(j);
+        auto &sl = m_slots[key];
+        auto at = [&sl](std::size_t i) -> const label_type &
+        {
+          return *sl.m_its[i];
+        };
+
+        // A few labels we compare one by one.
+        if (sl.m_its.size() < boe_any_min)
+          {
+            for(auto k = sl.m_its.size(); k--;)
+              if (boe(j, at(k)))
+                {
+                  auto i = sl.m_its[k];
+                  remove_slot(key, k);
+                  vd.erase(i);
+                }
+            return;
+          }
+
+        for(auto first = sl.m_c.size() / 64 * 64 + 64; first;)
+          {
+            first -= 64;
+            auto n = std::min<std::size_t>(64, sl.m_c.size() - first);
+            if (!n)
+              continue;
+
+            auto m = boe_batch(sl.m_c, first, n, j, at).m_woe;
+            for(; m; m &= ~(std::uint64_t(1) << (63 - std::countl_zero(m))))
+              {
+                auto k = first + 63 - std::countl_zero(m);
+                auto i = sl.m_its[k];
+                remove_slot(key, k);
+                vd.erase(i);
+              }
+          }
+
+        return;
+      }
+
     // Since labels (for a given key) are sorted with <, we:
     //
     // * iterate in the reverse order because the worse labels are
@@ -206,7 +523,7 @@ template <typename Label>
 bool
 has_better_or_equal(const generic_tentative<Label> &T, const Label &j)
 {
-  return boe(T[get_key(j)], j);
+  return T.has_boe(get_key(j), j);
 }
 
 #endif // GENERIC_TENTATIVE_HPP
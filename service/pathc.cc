@@ -0,0 +1,144 @@
+#include "service_protocol.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// The test client of the path-computation daemon: every connection
+// sends its queries between random vertexes, keeping at most window
+// of them unanswered, and every updates-th message is an update of a
+// random edge.
+//
+// pathc socket vertexes edges units [connections [queries [window
+//   [updates]]]]
+
+using namespace std;
+
+int
+connect_to(const char *path)
+{
+  sockaddr_un a{};
+  a.sun_family = AF_UNIX;
+  strncpy(a.sun_path, path, sizeof(a.sun_path) - 1);
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || ::connect(fd, (const sockaddr *)&a, sizeof(a)) < 0)
+    {
+      perror("connect");
+      exit(1);
+    }
+
+  return fd;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc < 5)
+    {
+      cerr << "usage: " << argv[0] << " socket vertexes edges units"
+           << " [connections [queries [window [updates]]]]" << endl;
+      return 1;
+    }
+
+  const char *path = argv[1];
+  unsigned vertexes = atoi(argv[2]);
+  unsigned edges = atoi(argv[3]);
+  unsigned units = atoi(argv[4]);
+  unsigned connections = argc > 5 ? atoi(argv[5]) : 8;
+  unsigned queries = argc > 6 ? atoi(argv[6]) : 10000;
+  unsigned window = argc > 7 ? atoi(argv[7]) : 16;
+  unsigned updates = argc > 8 ? atoi(argv[8]) : 0;
+
+  atomic<uint64_t> paths = 0, failed = 0;
+
+  auto t0 = chrono::steady_clock::now();
+
+  {
+    vector<jthread> threads;
+
+    for(unsigned c = 0; c < connections; ++c)
+      threads.emplace_back([&, c]
+      {
+        int fd = connect_to(path);
+        mt19937 gen(c);
+        uniform_int_distribution<unsigned> vd(0, vertexes - 1);
+        uniform_int_distribution<unsigned> ed(0, edges - 1);
+        uniform_int_distribution<unsigned> ud(0, units - 1);
+
+        // The writer sends the messages, and this thread reads the
+        // replies, and lets the writer send more.
+        atomic<unsigned> answered = 0;
+
+        jthread writer([&]
+        {
+          for(unsigned i = 0; i < queries; ++i)
+            {
+              while(i - answered >= window)
+                this_thread::yield();
+
+              service_message m{};
+              m.m_id = i;
+              if (updates && i % updates == updates - 1)
+                {
+                  unsigned a = ud(gen), b = ud(gen);
+                  if (a > b)
+                    swap(a, b);
+                  m.m_type = service_update;
+                  m.m_a = ed(gen);
+                  m.m_b = a;
+                  m.m_c = b + 1;
+                }
+              else
+                {
+                  m.m_type = service_query;
+                  m.m_a = vd(gen);
+                  m.m_b = vd(gen);
+                  m.m_c = 1;
+                  m.m_d = 1;
+                }
+
+              if (!write_full(fd, &m, sizeof(m)))
+                {
+                  perror("write");
+                  exit(1);
+                }
+            }
+        });
+
+        service_answer a;
+        for(unsigned i = 0; i < queries; ++i, ++answered)
+          {
+            if (!read_answer(fd, a))
+              {
+                cerr << "connection closed" << endl;
+                exit(1);
+              }
+            paths += a.m_header.m_a;
+            failed += a.m_header.m_c != service_ok;
+          }
+
+        writer.join();
+        ::close(fd);
+      });
+  }
+
+  auto t1 = chrono::steady_clock::now();
+  double s = chrono::duration<double>(t1 - t0).count();
+  uint64_t total = uint64_t(connections) * queries;
+
+  cout << total << " requests in " << fixed << setprecision(3) << s
+       << " s: " << setprecision(0) << total / s << " requests/s, "
+       << paths << " paths, " << failed << " failed" << endl;
+}
@@ -0,0 +1,109 @@
+#include "service_graph.hpp"
+#include "service_server.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// The path-computation daemon: loads the graph once, and answers the
+// queries of the clients on a Unix-domain socket.
+//
+// pathd graph socket [workers [batch [linger]]]
+//
+// The workers is the number of threads that run the queries of a
+// batch, the batch is the largest number of requests in a batch, and
+// the linger is how many microseconds we wait for a batch to fill up.
+//
+// SIGINT or SIGTERM stops the daemon: it closes the connections, and
+// waits for their threads.
+
+using namespace std;
+
+// Set by the signal handler.
+volatile sig_atomic_t stopped = 0;
+
+extern "C" void
+on_signal(int)
+{
+  stopped = 1;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc < 3)
+    {
+      cerr << "usage: " << argv[0]
+           << " graph socket [workers [batch [linger]]]" << endl;
+      return 1;
+    }
+
+  unsigned workers = argc > 3 ? atoi(argv[3]) :
+    std::thread::hardware_concurrency();
+  size_t batch = argc > 4 ? atoi(argv[4]) : 64;
+  chrono::microseconds linger(argc > 5 ? atoi(argv[5]) : 100);
+
+  ifstream in(argv[1]);
+  if (!in)
+    {
+      cerr << "cannot open " << argv[1] << endl;
+      return 1;
+    }
+
+  service_graph g(in);
+  cerr << "loaded " << g.size() << " vertexes and " << g.m_edges.size()
+       << " edges" << endl;
+
+  sockaddr_un a{};
+  a.sun_family = AF_UNIX;
+  if (strlen(argv[2]) >= sizeof(a.sun_path))
+    {
+      cerr << "socket path too long" << endl;
+      return 1;
+    }
+  strcpy(a.sun_path, argv[2]);
+
+  int s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ::unlink(argv[2]);
+  if (s < 0 || ::bind(s, (const sockaddr *)&a, sizeof(a)) < 0 ||
+      ::listen(s, SOMAXCONN) < 0)
+    {
+      perror("socket");
+      return 1;
+    }
+
+  // No SA_RESTART, so that the signal interrupts accept.
+  struct sigaction sa{};
+  sa.sa_handler = on_signal;
+  ::sigaction(SIGINT, &sa, nullptr);
+  ::sigaction(SIGTERM, &sa, nullptr);
+
+  service_server server(g, workers, batch, linger);
+  cerr << "listening on " << argv[2] << " with " << workers
+       << " workers" << endl;
+
+  while(!stopped)
+    {
+      int fd = ::accept(s, nullptr, nullptr);
+      if (fd < 0)
+        continue;
+
+      // The server owns the thread of the connection, which ends when
+      // the client closes the connection, or when the server stops.
+      server.connect(fd);
+    }
+
+  cerr << "stopping" << endl;
+  ::close(s);
+  ::unlink(argv[2]);
+}
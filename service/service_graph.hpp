@@ -0,0 +1,225 @@
+#ifndef SERVICE_GRAPH_HPP
+#define SERVICE_GRAPH_HPP
+
+#include "generic_label.hpp"
+#include "generic_label_creator.hpp"
+#include "props.hpp"
+#include "units.hpp"
+
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// The graph of the service: the edges have unsigned weights and
+// contiguous resources (CU), and the resources of an edge can be
+// updated.  The graph has just enough of the graph interface for the
+// generic containers and functions.
+
+struct service_vertex;
+
+struct service_edge: weight<unsigned>, resources<CU>
+{
+  const service_vertex *m_source;
+  const service_vertex *m_target;
+  // The key of the edge: its number in the graph file.
+  unsigned m_key;
+
+  service_edge(const service_vertex &s, const service_vertex &t,
+               unsigned w, const CU &r, unsigned key = ~0U):
+    weight<unsigned>(w), resources<CU>(r), m_source(&s), m_target(&t),
+    m_key(key)
+  {
+  }
+
+  // The edges are the same if they are the same object.
+  bool
+  operator == (const service_edge &e) const
+  {
+    return this == &e;
+  }
+};
+
+struct service_vertex
+{
+  unsigned m_key;
+  // The out-edges.
+  std::vector<service_edge> m_edges;
+
+  // The vertexes are the same if they are the same object.
+  bool
+  operator == (const service_vertex &v) const
+  {
+    return this == &v;
+  }
+};
+
+inline const service_vertex &
+get_source(const service_edge &e)
+{
+  return *e.m_source;
+}
+
+inline const service_vertex &
+get_target(const service_edge &e)
+{
+  return *e.m_target;
+}
+
+inline unsigned
+get_key(const service_vertex &v)
+{
+  return v.m_key;
+}
+
+inline unsigned
+get_key(const service_edge &e)
+{
+  return e.m_key;
+}
+
+inline const auto &
+get_edges(const service_vertex &v)
+{
+  return v.m_edges;
+}
+
+// The graph.  The vertexes and the edges do not move once the graph
+// is built, because the labels refer to them.
+struct service_graph: std::vector<service_vertex>
+{
+  // The number of units of the resources.
+  unsigned m_units;
+  // The edges in the order of their keys.
+  std::vector<service_edge *> m_edges;
+
+  // Reads the graph in the format:
+  //
+  // vertexes edges units
+  // source target weight min max
+  // ...
+  //
+  // with a line for every edge, whose resources are [min, max).
+  service_graph(std::istream &in)
+  {
+    unsigned count, edges;
+    if (!(in >> count >> edges >> m_units))
+      throw std::runtime_error("graph: bad header");
+
+    reserve(count);
+    for(unsigned i = 0; i < count; ++i)
+      push_back(service_vertex{i, {}});
+
+    struct line
+    {
+      unsigned s, t, w, min, max;
+    };
+
+    // We read the edges first, so that we can reserve the out-edges,
+    // and they do not move.
+    std::vector<line> ls(edges);
+    std::vector<unsigned> degree(count);
+    for(auto &l: ls)
+      {
+        if (!(in >> l.s >> l.t >> l.w >> l.min >> l.max) ||
+            l.s >= count || l.t >= count || l.min >= l.max ||
+            l.max > m_units)
+          throw std::runtime_error("graph: bad edge");
+        ++degree[l.s];
+      }
+
+    for(unsigned i = 0; i < count; ++i)
+      operator[](i).m_edges.reserve(degree[i]);
+
+    m_edges.reserve(edges);
+    for(unsigned k = 0; k < edges; ++k)
+      {
+        const auto &l = ls[k];
+        auto &v = operator[](l.s);
+        v.m_edges.emplace_back(v, operator[](l.t), l.w,
+                               CU(l.min, l.max), k);
+        m_edges.push_back(&v.m_edges.back());
+      }
+  }
+
+  service_graph(const service_graph &) = delete;
+  service_graph &operator = (const service_graph &) = delete;
+
+  // Sets the resources of edge k.
+  void
+  update(unsigned k, const CU &r)
+  {
+    static_cast<resources<CU> &>(*m_edges.at(k)) = resources<CU>(r);
+  }
+};
+
+// The label of the service: the key is the key of the target of the
+// edge.
+struct service_label: generic_label<unsigned, CU>, key<unsigned>
+{
+  using label_type = generic_label<unsigned, CU>;
+
+  const service_edge *m_edge;
+
+  service_label(const label_type &l, const service_edge &e):
+    label_type(l), key<unsigned>(get_key(get_target(e))), m_edge(&e)
+  {
+  }
+
+  // The edge and the key do not take part in comparisons.
+  bool operator == (const service_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l);
+  }
+
+  auto operator <=> (const service_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+inline const service_edge &
+get_edge(const service_label &l)
+{
+  return *l.m_edge;
+}
+
+// The candidate labels of a relaxation: none or one.
+struct service_candidates
+{
+  std::optional<service_label> m_l;
+
+  service_label *
+  begin()
+  {
+    return m_l ? &*m_l : nullptr;
+  }
+
+  service_label *
+  end()
+  {
+    return m_l ? &*m_l + 1 : nullptr;
+  }
+};
+
+// Produces the candidate label for a label and an edge, if its
+// resources can fit the demand of the given width.
+struct service_functor
+{
+  unsigned m_width;
+
+  service_candidates
+  operator()(const service_label &l, const service_edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty() || r.max() - r.min() < m_width)
+      return {};
+
+    return {service_label({w, r}, e)};
+  }
+};
+
+#endif // SERVICE_GRAPH_HPP
@@ -0,0 +1,115 @@
+#ifndef SERVICE_PROTOCOL_HPP
+#define SERVICE_PROTOCOL_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// The protocol of the service.  A client sends messages, and the
+// service answers every message with a reply of the same id.  The
+// numbers are 32-bit, in the byte order of the machine, since the
+// client and the service run on the same machine.
+//
+// A message is a service_message.  A reply is a service_message of
+// type reply, followed by m_b words: for each of the m_a paths, the
+// weight, the min and the max of the resources, the number of edges,
+// and the keys of the edges, from the source to the target.
+
+enum service_type: std::uint32_t
+  {
+    // Find at most m_d (all if 0) paths from vertex m_a to vertex m_b
+    // for the demand of m_c units.
+    service_query = 1,
+    // Set the resources of edge m_a to [m_b, m_c).  The update is
+    // applied after the queries received before it, and before the
+    // queries received after it.
+    service_update = 2,
+    // The reply: m_a paths in m_b words, and status m_c.
+    service_reply = 3
+  };
+
+enum service_status: std::uint32_t
+  {
+    service_ok = 0,
+    // The message had a wrong type, or wrong numbers.
+    service_bad_request = 1
+  };
+
+struct service_message
+{
+  std::uint32_t m_type;
+  std::uint32_t m_id;
+  std::uint32_t m_a;
+  std::uint32_t m_b;
+  std::uint32_t m_c;
+  std::uint32_t m_d;
+};
+
+// Reads n bytes.  Returns false at the end of the stream, or on an
+// error.
+inline bool
+read_full(int fd, void *p, std::size_t n)
+{
+  auto b = static_cast<char *>(p);
+
+  while(n)
+    {
+      auto r = ::read(fd, b, n);
+      if (r < 0 && errno == EINTR)
+        continue;
+      if (r <= 0)
+        return false;
+      b += r;
+      n -= r;
+    }
+
+  return true;
+}
+
+// Writes n bytes.  Returns false on an error.
+inline bool
+write_full(int fd, const void *p, std::size_t n)
+{
+  auto b = static_cast<const char *>(p);
+
+  while(n)
+    {
+      // We do not want SIGPIPE when the other end is closed.
+      auto r = ::send(fd, b, n, MSG_NOSIGNAL);
+      if (r < 0 && errno == EINTR)
+        continue;
+      if (r <= 0)
+        return false;
+      b += r;
+      n -= r;
+    }
+
+  return true;
+}
+
+// A reply as received by a client.
+struct service_answer
+{
+  service_message m_header;
+  std::vector<std::uint32_t> m_words;
+};
+
+// Reads a reply.
+inline bool
+read_answer(int fd, service_answer &a)
+{
+  if (!read_full(fd, &a.m_header, sizeof(a.m_header)) ||
+      a.m_header.m_type != service_reply)
+    return false;
+
+  a.m_words.resize(a.m_header.m_b);
+
+  return read_full(fd, a.m_words.data(),
+                   a.m_words.size() * sizeof(std::uint32_t));
+}
+
+#endif // SERVICE_PROTOCOL_HPP
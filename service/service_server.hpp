@@ -0,0 +1,548 @@
+#ifndef SERVICE_SERVER_HPP
+#define SERVICE_SERVER_HPP
+
+#include "service_graph.hpp"
+#include "service_protocol.hpp"
+
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// The connection of a client.  The workers do not write the replies
+// to the socket, because a client that does not read its replies
+// would hold them up, and the other clients too.  They put the
+// replies into the outgoing buffer, and the writer of the connection
+// drains it.  The buffer is bounded: a client whose replies do not
+// fit is too slow, and we disconnect it.
+//
+// The socket is closed when the last request of the connection is
+// answered, and the connection is closed by the client.
+struct service_connection
+{
+  int m_fd;
+  // The largest number of words in the outgoing buffer.
+  std::size_t m_max_out;
+
+  std::mutex m_m;
+  std::condition_variable m_cv;
+  // The replies not yet written.
+  std::vector<std::uint32_t> m_out;
+  // The number of requests not yet answered.
+  std::size_t m_pending = 0;
+  // The client sends no more requests.
+  bool m_eof = false;
+  // The connection is closed: we drop the replies.
+  bool m_closed = false;
+
+  service_connection(int fd, std::size_t max_out = 1 << 20):
+    m_fd(fd), m_max_out(max_out)
+  {
+  }
+
+  service_connection(const service_connection &) = delete;
+  service_connection &operator = (const service_connection &) = delete;
+
+  ~service_connection()
+  {
+    ::close(m_fd);
+  }
+
+  // A request was received, and it is to be answered.
+  void
+  expect()
+  {
+    std::lock_guard l(m_m);
+    ++m_pending;
+  }
+
+  // The client sends no more requests.
+  void
+  finish()
+  {
+    {
+      std::lock_guard l(m_m);
+      m_eof = true;
+    }
+    m_cv.notify_all();
+  }
+
+  // Closes the connection: the reader and the writer of the
+  // connection stop, and the replies are dropped.
+  void
+  close()
+  {
+    {
+      std::lock_guard l(m_m);
+      m_closed = true;
+      m_out.clear();
+    }
+    // Wakes up the reader and the writer if they are blocked on the
+    // socket.
+    ::shutdown(m_fd, SHUT_RDWR);
+    m_cv.notify_all();
+  }
+
+  bool
+  closed()
+  {
+    std::lock_guard l(m_m);
+    return m_closed;
+  }
+
+  // Puts the reply of the given id and status, with the given number
+  // of paths in the given words, into the outgoing buffer.
+  void
+  reply(std::uint32_t id, std::uint32_t status, std::uint32_t paths,
+        const std::vector<std::uint32_t> &words)
+  {
+    service_message h{service_reply, id, paths,
+                      static_cast<std::uint32_t>(words.size()), status, 0};
+    constexpr auto hw = sizeof(h) / sizeof(std::uint32_t);
+
+    {
+      std::lock_guard l(m_m);
+      assert(m_pending);
+      --m_pending;
+
+      // The client may be gone, and then there is nobody to tell.
+      if (m_closed)
+        return;
+
+      if (m_out.size() + hw + words.size() <= m_max_out)
+        {
+          auto n = m_out.size();
+          m_out.resize(n + hw);
+          std::memcpy(m_out.data() + n, &h, sizeof(h));
+          m_out.insert(m_out.end(), words.begin(), words.end());
+          m_cv.notify_all();
+          return;
+        }
+    }
+
+    // The client does not read its replies.
+    close();
+  }
+
+  // Writes the replies until the connection is closed, or the client
+  // sends no more requests, and all of them were answered.  Run it on
+  // the writer thread of the connection.
+  void
+  drain()
+  {
+    std::vector<std::uint32_t> out;
+    std::unique_lock l(m_m);
+
+    while(true)
+      {
+        m_cv.wait(l, [this]
+        {
+          return m_closed || !m_out.empty() || (m_eof && !m_pending);
+        });
+
+        if (m_closed || m_out.empty())
+          return;
+
+        // We write without the lock, so that the workers can add more
+        // replies meanwhile.
+        out.swap(m_out);
+        l.unlock();
+        bool ok = write_full(m_fd, out.data(),
+                             out.size() * sizeof(std::uint32_t));
+        out.clear();
+        if (!ok)
+          {
+            close();
+            return;
+          }
+        l.lock();
+      }
+  }
+};
+
+struct service_request
+{
+  std::shared_ptr<service_connection> m_c;
+  service_message m_m;
+};
+
+// The requests of all connections, in the order they were received.
+// The queue is bounded: when it is full, the connections wait before
+// they read more requests, and so the clients wait to send them.
+struct service_queue
+{
+  std::mutex m_m;
+  std::condition_variable m_cv;
+  // Notified when there is room in the queue.
+  std::condition_variable m_room_cv;
+  std::deque<service_request> m_q;
+  // The largest number of requests in the queue.
+  std::size_t m_max;
+  bool m_stopped = false;
+
+  service_queue(std::size_t max): m_max(std::max<std::size_t>(max, 1))
+  {
+  }
+
+  // Returns false when stopped.
+  bool
+  push(service_request r)
+  {
+    {
+      std::unique_lock l(m_m);
+      m_room_cv.wait(l, [this]{return m_stopped || m_q.size() < m_max;});
+      if (m_stopped)
+        return false;
+      m_q.push_back(std::move(r));
+    }
+    m_cv.notify_one();
+
+    return true;
+  }
+
+  // Takes a batch of at most max requests.  Waits for the first
+  // request, and then at most for linger for the batch to fill up.
+  // Returns false when stopped.
+  bool
+  take(std::vector<service_request> &rs, std::size_t max,
+       std::chrono::microseconds linger)
+  {
+    std::unique_lock l(m_m);
+
+    m_cv.wait(l, [this]{return m_stopped || !m_q.empty();});
+    if (m_stopped)
+      return false;
+
+    m_cv.wait_for(l, linger, [&]{return m_stopped || m_q.size() >= max;});
+
+    auto n = std::min(max, m_q.size());
+    rs.assign(std::make_move_iterator(m_q.begin()),
+              std::make_move_iterator(m_q.begin() + n));
+    m_q.erase(m_q.begin(), m_q.begin() + n);
+    m_room_cv.notify_all();
+
+    return true;
+  }
+
+  void
+  stop()
+  {
+    {
+      std::lock_guard l(m_m);
+      m_stopped = true;
+    }
+    m_cv.notify_all();
+    m_room_cv.notify_all();
+  }
+};
+
+// The threads that run the queries of a batch.
+struct service_pool
+{
+  std::mutex m_m;
+  std::condition_variable m_cv;
+  std::condition_variable m_done_cv;
+  // The task of the current batch, and its number of queries.
+  std::function<void(std::size_t)> m_f;
+  std::size_t m_n = 0;
+  // The next query to run, and the number of queries run.
+  std::atomic<std::size_t> m_next = 0;
+  std::size_t m_done = 0;
+  // The number of workers that run the queries of a batch.  The next
+  // batch cannot start before they stop reading the current one.
+  std::size_t m_active = 0;
+  // Incremented for every batch, so that a worker knows there is a
+  // new one.
+  std::uint64_t m_generation = 0;
+  bool m_stopped = false;
+  std::vector<std::jthread> m_threads;
+
+  service_pool(unsigned workers)
+  {
+    for(unsigned i = 0; i < std::max(workers, 1U); ++i)
+      m_threads.emplace_back([this]{work();});
+  }
+
+  ~service_pool()
+  {
+    {
+      std::lock_guard l(m_m);
+      m_stopped = true;
+    }
+    m_cv.notify_all();
+  }
+
+  // Runs f(i) for every i in [0, n), and returns when all are done.
+  void
+  run(std::size_t n, std::function<void(std::size_t)> f)
+  {
+    if (!n)
+      return;
+
+    std::unique_lock l(m_m);
+    // A worker late for the last batch may still look at it.
+    m_done_cv.wait(l, [&]{return !m_active;});
+
+    m_f = std::move(f);
+    m_n = n;
+    m_next = 0;
+    m_done = 0;
+    ++m_generation;
+    m_cv.notify_all();
+
+    m_done_cv.wait(l, [&]{return m_done == m_n && !m_active;});
+  }
+
+  void
+  work()
+  {
+    std::uint64_t seen = 0;
+    std::unique_lock l(m_m);
+
+    while(true)
+      {
+        m_cv.wait(l, [&]{return m_stopped || m_generation != seen;});
+        if (m_stopped)
+          return;
+        seen = m_generation;
+        ++m_active;
+
+        l.unlock();
+        std::size_t count = 0;
+        for(std::size_t i; (i = m_next++) < m_n; ++count)
+          m_f(i);
+        l.lock();
+
+        m_done += count;
+        if (!--m_active)
+          m_done_cv.notify_one();
+      }
+  }
+};
+
+// The service: the connections push their requests into the queue,
+// and the dispatcher takes them in batches.  The queries of a batch
+// are run by the workers at the same time, and the updates are
+// applied between them, when no query runs, and so the graph needs no
+// locks.  A batch is cut at an update: the queries received before
+// the update run before it, and the queries received after it run
+// after it.
+struct service_server
+{
+  service_graph &m_g;
+  // The largest batch, and how long we wait for it to fill up.
+  std::size_t m_batch;
+  std::chrono::microseconds m_linger;
+  // The largest number of words in the outgoing buffer of a
+  // connection.
+  std::size_t m_max_out;
+
+  service_queue m_q;
+  service_pool m_pool;
+
+  // A connection started with connect, and its thread.
+  struct client
+  {
+    std::shared_ptr<service_connection> m_c;
+    std::atomic<bool> m_done = false;
+    std::jthread m_t;
+  };
+
+  // The connections started with connect.
+  std::mutex m_clients_m;
+  std::list<client> m_clients;
+
+  // The statistics.
+  std::atomic<std::uint64_t> m_batches = 0;
+  std::atomic<std::uint64_t> m_queries = 0;
+  std::atomic<std::uint64_t> m_updates = 0;
+
+  // Declared last, so that it starts when the rest is ready.
+  std::jthread m_dispatcher;
+
+  // The queue holds at most queue requests.
+  service_server(service_graph &g, unsigned workers, std::size_t batch,
+                 std::chrono::microseconds linger,
+                 std::size_t queue = 4096, std::size_t max_out = 1 << 20):
+    m_g(g), m_batch(std::max<std::size_t>(batch, 1)), m_linger(linger),
+    m_max_out(max_out), m_q(queue), m_pool(workers),
+    m_dispatcher([this]{dispatch();})
+  {
+  }
+
+  // Closes the connections started with connect, and waits for their
+  // threads.  The connections served by the caller with serve have to
+  // be closed by the caller.
+  ~service_server()
+  {
+    m_q.stop();
+
+    std::lock_guard l(m_clients_m);
+    for(auto &c: m_clients)
+      c.m_c->close();
+    m_clients.clear();
+  }
+
+  // Serves the connection on a thread of the server.  The server takes
+  // over the socket.
+  void
+  connect(int fd)
+  {
+    std::lock_guard l(m_clients_m);
+
+    // The threads of the connections that ended are joined.
+    m_clients.remove_if([](const client &c){return c.m_done.load();});
+
+    auto &c = m_clients.emplace_back();
+    c.m_c = std::make_shared<service_connection>(fd, m_max_out);
+    c.m_t = std::jthread([this, &c]
+    {
+      serve(c.m_c);
+      c.m_done = true;
+    });
+  }
+
+  // Reads the requests of a connection until the client closes it, and
+  // returns when they are answered.  Run it on a thread of the
+  // connection.  The server takes over the socket.
+  void
+  serve(int fd)
+  {
+    serve(std::make_shared<service_connection>(fd, m_max_out));
+  }
+
+  void
+  serve(std::shared_ptr<service_connection> c)
+  {
+    // The writer of the connection.
+    std::jthread w([&c]{c->drain();});
+    service_message m;
+
+    while(!c->closed() && read_full(c->m_fd, &m, sizeof(m)))
+      {
+        c->expect();
+        if (!m_q.push({c, m}))
+          {
+            // The server stops.
+            c->close();
+            break;
+          }
+      }
+
+    c->finish();
+  }
+
+  void
+  dispatch()
+  {
+    std::vector<service_request> rs;
+
+    while(m_q.take(rs, m_batch, m_linger))
+      {
+        ++m_batches;
+
+        for(std::size_t i = 0; i < rs.size();)
+          {
+            auto j = i;
+            while(j < rs.size() && rs[j].m_m.m_type != service_update)
+              ++j;
+
+            m_pool.run(j - i, [&, i](std::size_t k)
+            {
+              query(rs[i + k]);
+            });
+
+            for(; j < rs.size() && rs[j].m_m.m_type == service_update; ++j)
+              update(rs[j]);
+
+            i = j;
+          }
+      }
+  }
+
+  void
+  query(const service_request &r)
+  {
+    const auto &m = r.m_m;
+
+    if (m.m_type != service_query || m.m_a >= m_g.size() ||
+        m.m_b >= m_g.size())
+      {
+        r.m_c->reply(m.m_id, service_bad_request, 0, {});
+        return;
+      }
+
+    ++m_queries;
+
+    // The containers of the search.
+    generic_permanent<service_label> P(m_g.size());
+    generic_tentative<service_label> T(m_g.size());
+    service_functor f{m.m_c};
+    const CU units(0, m_g.m_units);
+    service_edge ie(m_g[m.m_a], m_g[m.m_a], 0, units);
+    service_label initial({0, units}, ie);
+
+    std::vector<std::uint32_t> words;
+    std::uint32_t paths = 0;
+
+    for(const auto &l: generic_search(P, T, f, initial, m.m_b))
+      {
+        words.push_back(get_weight(l));
+        words.push_back(get_resources(l).min());
+        words.push_back(get_resources(l).max());
+        // The number of edges, which we know at the end.
+        auto n = words.size();
+        words.push_back(0);
+
+        // The path goes from the target to the source.
+        for(const auto &pl: generic_path_range(P, f, l, initial))
+          words.push_back(get_key(get_edge(pl)));
+        std::reverse(words.begin() + n + 1, words.end());
+        words[n] = words.size() - n - 1;
+
+        if (++paths == m.m_d)
+          break;
+      }
+
+    r.m_c->reply(m.m_id, service_ok, paths, words);
+  }
+
+  void
+  update(const service_request &r)
+  {
+    const auto &m = r.m_m;
+
+    if (m.m_a >= m_g.m_edges.size() || m.m_b >= m.m_c ||
+        m.m_c > m_g.m_units)
+      {
+        r.m_c->reply(m.m_id, service_bad_request, 0, {});
+        return;
+      }
+
+    ++m_updates;
+    m_g.update(m.m_a, CU(m.m_b, m.m_c));
+    r.m_c->reply(m.m_id, service_ok, 0, {});
+  }
+};
+
+#endif // SERVICE_SERVER_HPP
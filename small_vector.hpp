@@ -0,0 +1,322 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// A vector that stores up to N elements inline, i.e., in the object
+// itself, and only more elements on the heap.  We need just a few
+// functions of std::vector: those used by the per-key containers of
+// labels.
+//
+// As with std::vector, pushing an element can invalidate references
+// to other elements, both when they move from the inline buffer to
+// the heap, and when they move to a larger heap buffer.
+template <typename T, std::size_t N>
+struct small_vector
+{
+  static_assert(N > 0);
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  // The elements: either in m_buffer or on the heap.
+  T *m_data;
+  // The number of elements.
+  size_type m_size = 0;
+  // The number of elements that fit in m_data.
+  size_type m_capacity = N;
+  // The inline storage.
+  alignas(T) std::byte m_buffer[N * sizeof(T)];
+
+  small_vector(): m_data(inline_data())
+  {
+  }
+
+  small_vector(const small_vector &v): small_vector()
+  {
+    reserve(v.m_size);
+    std::uninitialized_copy(v.begin(), v.end(), m_data);
+    m_size = v.m_size;
+  }
+
+  small_vector(small_vector &&v) noexcept: small_vector()
+  {
+    steal(v);
+  }
+
+  ~small_vector()
+  {
+    clear();
+    release();
+  }
+
+  small_vector &
+  operator = (const small_vector &v)
+  {
+    if (this != &v)
+      {
+        clear();
+        reserve(v.m_size);
+        std::uninitialized_copy(v.begin(), v.end(), m_data);
+        m_size = v.m_size;
+      }
+
+    return *this;
+  }
+
+  small_vector &
+  operator = (small_vector &&v) noexcept
+  {
+    if (this != &v)
+      {
+        clear();
+        release();
+        m_data = inline_data();
+        m_capacity = N;
+        steal(v);
+      }
+
+    return *this;
+  }
+
+  template <typename... Args>
+  T &
+  emplace_back(Args &&...args)
+  {
+    if (m_size < m_capacity)
+      std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    else
+      {
+        // We construct the new element before we move the old ones,
+        // because args can refer to an old element.  If that throws,
+        // or moving the old ones throws, the guards destroy the new
+        // element and free the new buffer, and we keep the old one.
+        size_type capacity = 2 * m_capacity;
+        buffer_guard b(capacity);
+        std::construct_at(b.m_data + m_size, std::forward<Args>(args)...);
+        element_guard e{b.m_data + m_size};
+        relocate(b.m_data);
+        e.m_p = nullptr;
+        adopt(b);
+      }
+
+    return m_data[m_size++];
+  }
+
+  void
+  push_back(const T &t)
+  {
+    emplace_back(t);
+  }
+
+  void
+  push_back(T &&t)
+  {
+    emplace_back(std::move(t));
+  }
+
+  void
+  reserve(size_type capacity)
+  {
+    if (capacity <= m_capacity)
+      return;
+
+    buffer_guard b(capacity);
+    relocate(b.m_data);
+    adopt(b);
+  }
+
+  void
+  clear()
+  {
+    std::destroy(begin(), end());
+    m_size = 0;
+  }
+
+  // Are the elements inline?
+  bool
+  is_inline() const
+  {
+    return m_data == inline_data();
+  }
+
+  size_type
+  size() const
+  {
+    return m_size;
+  }
+
+  size_type
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  bool
+  empty() const
+  {
+    return !m_size;
+  }
+
+  T &
+  operator[](size_type i)
+  {
+    assert(i < m_size);
+    return m_data[i];
+  }
+
+  const T &
+  operator[](size_type i) const
+  {
+    assert(i < m_size);
+    return m_data[i];
+  }
+
+  T &
+  back()
+  {
+    assert(m_size);
+    return m_data[m_size - 1];
+  }
+
+  const T &
+  back() const
+  {
+    assert(m_size);
+    return m_data[m_size - 1];
+  }
+
+  iterator
+  begin()
+  {
+    return m_data;
+  }
+
+  iterator
+  end()
+  {
+    return m_data + m_size;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_data;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_data + m_size;
+  }
+
+private:
+  // The new heap buffer, which we free if it is not adopted, e.g.,
+  // when constructing the elements in it throws.
+  struct buffer_guard
+  {
+    T *m_data;
+    size_type m_capacity;
+
+    buffer_guard(size_type capacity):
+      m_data(std::allocator<T>().allocate(capacity)), m_capacity(capacity)
+    {
+    }
+
+    ~buffer_guard()
+    {
+      if (m_data)
+        std::allocator<T>().deallocate(m_data, m_capacity);
+    }
+  };
+
+  // The element we destroy, unless dismissed with nullptr.
+  struct element_guard
+  {
+    T *m_p;
+
+    ~element_guard()
+    {
+      if (m_p)
+        std::destroy_at(m_p);
+    }
+  };
+
+  // Constructs the elements in data.  As std::vector does, we copy the
+  // elements whose move can throw, if we can, so that if the copy
+  // throws, the elements stay as they were.  If it throws, the
+  // elements constructed in data are destroyed.
+  void
+  relocate(T *data)
+  {
+    if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>)
+      std::uninitialized_move(begin(), end(), data);
+    else
+      std::uninitialized_copy(begin(), end(), data);
+  }
+
+  // Destroys the elements, frees the buffer, and takes the buffer of
+  // b, to which the elements were relocated.
+  void
+  adopt(buffer_guard &b)
+  {
+    std::destroy(begin(), end());
+    release();
+    m_data = std::exchange(b.m_data, nullptr);
+    m_capacity = b.m_capacity;
+  }
+
+  T *
+  inline_data()
+  {
+    return reinterpret_cast<T *>(m_buffer);
+  }
+
+  const T *
+  inline_data() const
+  {
+    return reinterpret_cast<const T *>(m_buffer);
+  }
+
+  // Frees the heap buffer, if any.  The elements must be destroyed.
+  void
+  release()
+  {
+    if (!is_inline())
+      std::allocator<T>().deallocate(m_data, m_capacity);
+  }
+
+  // Takes the elements of v, which leaves v empty and inline.  This
+  // vector must be empty and inline.
+  void
+  steal(small_vector &v)
+  {
+    assert(empty() && is_inline());
+
+    if (v.is_inline())
+      {
+        std::uninitialized_move(v.begin(), v.end(), m_data);
+        m_size = v.m_size;
+        v.clear();
+      }
+    else
+      {
+        m_data = v.m_data;
+        m_size = v.m_size;
+        m_capacity = v.m_capacity;
+        v.m_data = v.inline_data();
+        v.m_size = 0;
+        v.m_capacity = N;
+      }
+  }
+};
+
+#endif // SMALL_VECTOR_HPP
@@ -0,0 +1,95 @@
+#include "generic_adaptive_permanent.hpp"
+#include "generic_permanent2.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+// The set switches to std::set past the threshold, and stays there.
+void
+test_set()
+{
+  adaptive_set<int, std::less<int>, 4> s;
+
+  for(int i: {3, 1, 4, 0})
+    s.insert(i);
+  assert(s.is_linear());
+  assert(s.size() == 4);
+
+  s.insert(2);
+  assert(!s.is_linear());
+  assert(s.size() == 5);
+
+  s.insert(6);
+  assert(!s.is_linear());
+
+  // The elements stay sorted.
+  s.visit([](const auto &c)
+  {
+    assert(std::ranges::equal(c, std::vector{0, 1, 2, 3, 4, 6}));
+  });
+}
+
+// The adaptive container should answer has_better_or_equal as
+// generic_permanent2 does, for both representations of a key.
+template <std::size_t Threshold>
+void
+test_boe()
+{
+  using robed_label = label_robe<CU>;
+  using label = robed_label::label_type;
+
+  generic_permanent2<robed_label> P2(1);
+  generic_adaptive_permanent<robed_label, Threshold> PA(1);
+
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<unsigned> w(0, 20), u(0, 20);
+
+  for(int n = 0; n < 500; ++n)
+    {
+      auto a = u(gen), b = u(gen);
+      if (a == b)
+        continue;
+      robed_label l(label(w(gen), {std::min(a, b), std::max(a, b)}), 0);
+
+      bool r = has_better_or_equal(P2, l);
+      assert(r == has_better_or_equal(PA, l));
+
+      // The containers require the labels to be boe-incomparable.
+      if (!r)
+        {
+          bool worse = false;
+          for(const auto &i: P2[0])
+            worse |= boe(l, i);
+
+          if (!worse)
+            {
+              P2.push(l);
+              PA.push(l);
+            }
+        }
+    }
+
+  // The key in std::set has the columns of all its labels.
+  assert(PA[0].is_linear() == (PA[0].size() <= Threshold));
+  assert(PA.m_slots[0].m_c.size() ==
+         (PA[0].is_linear() ? 0 : PA[0].size()));
+
+  assert(P2[0].size() == PA[0].size());
+  PA[0].visit([&](const auto &c)
+  {
+    assert(std::ranges::equal(c, P2[0]));
+  });
+}
+
+int
+main()
+{
+  test_set();
+  test_boe<2>();
+  test_boe<16>();
+  test_boe<1000>();
+}
@@ -0,0 +1,40 @@
+#include "generic_approx_permanent.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+using namespace std;
+
+using robed_label = label_robe<CU>;
+using label = robed_label::label_type;
+
+// The cap should reject any label once reached.
+void
+test_cap()
+{
+  generic_approx_permanent<robed_label> P(1, 2);
+
+  P.push(robed_label(label(1, {0, 1}), 0));
+  assert(!has_better_or_equal(P, robed_label(label(2, {1, 2}), 0)));
+  P.push(robed_label(label(2, {1, 2}), 0));
+  assert(has_better_or_equal(P, robed_label(label(3, {2, 3}), 0)));
+  assert(P.m_cap_rejected == 1);
+}
+
+// With no cap, the labels are compared with boe.
+void
+test_no_cap()
+{
+  generic_approx_permanent<robed_label> P(1);
+
+  P.push(robed_label(label(1, {0, 4}), 0));
+  assert(has_better_or_equal(P, robed_label(label(2, {1, 3}), 0)));
+  assert(!has_better_or_equal(P, robed_label(label(2, {3, 5}), 0)));
+  assert(P.m_cap_rejected == 0);
+}
+
+int
+main()
+{
+  test_cap();
+  test_no_cap();
+}
@@ -0,0 +1,108 @@
+#include "generic_approx_tentative.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "test_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+// The labels within (1 + eps) of the weight should be rejected, and
+// the worst ratio reported.
+void
+test_eps()
+{
+  std::deque<vertex> g;
+  g.emplace_back(0);
+  edge e(g[0], g[0], 0, CU(0, 9));
+
+  generic_approx_tentative<label> T(1, 0.1);
+
+  T.push(label({100, CU(0, 4)}, e));
+
+  // Exactly worse.
+  assert(has_better_or_equal(T, label({100, CU(1, 3)}, e)));
+  assert(T.m_stats.m_eps_rejected == 0);
+
+  // Within 10%.
+  assert(has_better_or_equal(T, label({95, CU(1, 3)}, e)));
+  assert(T.m_stats.m_eps_rejected == 1);
+  assert(T.m_stats.m_max_ratio == 100.0 / 95);
+
+  // Too light.
+  assert(!has_better_or_equal(T, label({90, CU(1, 3)}, e)));
+  // Incomparable resources.
+  assert(!has_better_or_equal(T, label({99, CU(3, 5)}, e)));
+
+  assert(T.error_bound(0) == 0);
+  assert(T.error_bound(2) > 0.1);
+}
+
+// The search with the approximate tentative labels makes fewer labels
+// permanent, and for every label of the exact search yields a label
+// with its resources, and within the error bound of its weight.
+void
+test_search()
+{
+  std::mt19937 gen(1);
+  std::size_t exact = 0, approx = 0, rejected = 0;
+  double bound = 0;
+
+  for(int k = 0; k < 200; ++k)
+    {
+      auto g = random_graph(30, 150, gen);
+      const unsigned src = 0, dst = 29;
+      edge ie(g[src], g[src], 0, CU(0, 9));
+      const label initial({0, CU(0, 9)}, ie);
+
+      generic_permanent<label> P1(g.size());
+      generic_tentative<label> T1(g.size());
+      std::vector<std::pair<label, unsigned>> ls1;
+      for(const auto &l: generic_search(P1, T1, functor(), initial, dst))
+        {
+          unsigned hops = 0;
+          for([[maybe_unused]] const auto &pl:
+                generic_path_range(P1, functor(), l, initial))
+            ++hops;
+          ls1.emplace_back(l, hops);
+        }
+
+      generic_permanent<label> P2(g.size());
+      generic_approx_tentative<label> T2(g.size(), 0.5);
+      std::vector<label> ls2;
+      for(const auto &l: generic_search(P2, T2, functor(), initial, dst))
+        ls2.push_back(l);
+
+      for(const auto &[l1, hops]: ls1)
+        {
+          double b = T2.error_bound(hops);
+          bound = std::max(bound, b);
+          assert(std::ranges::any_of(ls2, [&](const auto &l2)
+          {
+            return includes(get_resources(l2), get_resources(l1)) &&
+              get_weight(l2) <= (1 + b) * get_weight(l1);
+          }));
+        }
+
+      for(unsigned i = 0; i < g.size(); ++i)
+        {
+          exact += P1[i].size();
+          approx += P2[i].size();
+        }
+
+      rejected += T2.m_stats.m_eps_rejected;
+    }
+
+  assert(approx < exact);
+  assert(rejected > 0);
+  assert(bound > 0);
+}
+
+int
+main()
+{
+  test_eps();
+  test_search();
+}
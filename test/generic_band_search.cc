@@ -0,0 +1,185 @@
+#include "generic_band_search.hpp"
+#include "generic_permanent.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using permanent = generic_permanent<label>;
+using tentative = generic_tentative<label>;
+
+// Rejects the candidate labels narrower than the width.
+struct width_functor
+{
+  unsigned m_width;
+
+  std::vector<label>
+  operator()(const label &l, const edge &e) const
+  {
+    auto v = functor()(l, e);
+    std::erase_if(v, [this](const auto &c)
+    {
+      const auto &r = get_resources(c);
+      return r.max() - r.min() < m_width;
+    });
+    return v;
+  }
+};
+
+// Throws for the edges of the given key.
+struct throwing_functor
+{
+  unsigned m_key;
+
+  std::vector<label>
+  operator()(const label &l, const edge &e) const
+  {
+    if (get_key(e) == m_key)
+      throw std::runtime_error("throwing_functor");
+    return functor()(l, e);
+  }
+};
+
+// Every allocation of the width should fall in a band.
+void
+test_split_bands()
+{
+  CU r(10, 30);
+
+  for(unsigned width = 1; width <= 21; ++width)
+    for(std::size_t k = 1; k <= 25; ++k)
+      {
+        auto bands = split_bands(r, k, width);
+
+        if (width > 20)
+          {
+            assert(bands.empty());
+            continue;
+          }
+
+        assert(bands.size() == std::min<std::size_t>(k, 21 - width));
+
+        for(auto s = r.min(); s + width <= r.max(); ++s)
+          {
+            bool found = false;
+            for(const auto &b: bands)
+              found |= includes(b, CU(s, s + width));
+            assert(found);
+          }
+
+        for(const auto &b: bands)
+          assert(includes(r, b));
+      }
+}
+
+// The merged labels of the band searches should cover the labels of
+// one search of the whole resources: every merged label has a label
+// of the search that is better or equal, and for every label of the
+// search, and for every allocation of the width in its resources,
+// there is a merged label with the allocation that is not heavier.
+void
+test_search()
+{
+  std::mt19937 gen(1);
+  const unsigned width = 2;
+  const CU r(0, 9);
+  const width_functor f{width};
+
+  for(int n = 0; n < 50; ++n)
+    {
+      auto g = random_graph(20, 80, gen);
+      const unsigned src = 0, dst = 19;
+      edge ie(g[src], g[src], 0, r);
+
+      permanent P(g.size());
+      tentative T(g.size());
+      for([[maybe_unused]] const auto &l:
+            generic_search(P, T, f, label({0, r}, ie), dst))
+        ;
+
+      for(std::size_t k: {1, 2, 3, 8})
+        {
+          auto result = generic_band_search<permanent, tentative>
+            (g.size(), f, [&](const CU &b){return label({0, b}, ie);},
+             r, width, k, dst);
+          const auto &ls = result.m_labels;
+
+          for(std::size_t i = 0; i < ls.size(); ++i)
+            {
+              // The merged labels are sorted and boe-incomparable.
+              for(std::size_t j = 0; j < i; ++j)
+                {
+                  assert(*ls[j].second < *ls[i].second);
+                  assert(!boe(*ls[j].second, *ls[i].second));
+                }
+
+              bool found = false;
+              for(const auto &l: P[dst])
+                found |= boe(l, *ls[i].second);
+              assert(found);
+            }
+
+          for(const auto &l: P[dst])
+            {
+              const auto &lr = get_resources(l);
+              for(auto a = lr.min(); a + width <= lr.max(); ++a)
+                {
+                  bool found = false;
+                  for(const auto &[b, i]: ls)
+                    found |= get_weight(*i) <= get_weight(l) &&
+                      includes(get_resources(*i), CU(a, a + width));
+                  assert(found);
+                }
+            }
+        }
+    }
+}
+
+// We should reject no bands, and rethrow what a search throws.
+void
+test_errors()
+{
+  std::mt19937 gen(2);
+  auto g = random_graph(20, 80, gen);
+  edge ie(g[0], g[0], 0, CU(0, 9));
+  auto initial = [&](const CU &b){return label({0, b}, ie);};
+
+  bool thrown = false;
+  try
+    {
+      generic_band_search<permanent, tentative>
+        (g.size(), functor(), initial, CU(0, 9), 1, 0, 19u);
+    }
+  catch (const std::invalid_argument &)
+    {
+      thrown = true;
+    }
+  assert(thrown);
+
+  // The edges leave the source, so every band gets to the edge that
+  // throws.
+  thrown = false;
+  try
+    {
+      generic_band_search<permanent, tentative>
+        (g.size(), throwing_functor{get_key(g[0].m_edges.front())},
+         initial, CU(0, 9), 1, 4, 19u);
+    }
+  catch (const std::runtime_error &)
+    {
+      thrown = true;
+    }
+  assert(thrown);
+}
+
+int
+main()
+{
+  test_split_bands();
+  test_search();
+  test_errors();
+}
@@ -0,0 +1,295 @@
+#include "generic_boe_batch.hpp"
+#include "generic_tentative.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+using robed_label = label_robe<CU>;
+using label = robed_label::label_type;
+
+using su_robed_label = label_robe<SU>;
+using su_label = su_robed_label::label_type;
+
+static_assert(cu_batchable<robed_label>);
+static_assert(su_batchable<su_robed_label>);
+
+// Random labels of a small range, so that there are many equal and
+// comparable labels.
+auto
+random_labels(size_t n, mt19937 &gen, unsigned keys = 1)
+{
+  uniform_int_distribution<unsigned> d(0, 6), k(0, keys - 1);
+  vector<robed_label> v;
+
+  while(v.size() < n)
+    if (unsigned a = d(gen), b = d(gen); a < b)
+      v.emplace_back(label(d(gen), {a, b}), k(gen));
+
+  return v;
+}
+
+// Random labels of one or two contiguous resources.
+auto
+random_su_labels(size_t n, mt19937 &gen, unsigned keys = 1)
+{
+  uniform_int_distribution<unsigned> w(0, 6), u(0, 40), k(0, keys - 1);
+  vector<su_robed_label> v;
+
+  while(v.size() < n)
+    {
+      // The resources are at 0 or at 64 * boe_unit, and then their
+      // bitmaps are the same.
+      unsigned b = w(gen) % 2 * 64 * boe_unit;
+      unsigned p[] = {b + u(gen), b + u(gen), b + u(gen), b + u(gen)};
+      sort(begin(p), end(p));
+      if (p[0] == p[1] || p[1] >= p[2] || p[2] == p[3])
+        continue;
+
+      SU r{CU(p[0], p[1])};
+      if (w(gen) % 2)
+        r.insert(CU(p[2], p[3]));
+      v.emplace_back(su_label(w(gen), r), k(gen));
+    }
+
+  return v;
+}
+
+// The masks of boe for the labels of v and label j.
+template <typename Label>
+boe_masks
+expected(const vector<Label> &v, size_t first, size_t n, const Label &j)
+{
+  boe_masks e;
+
+  for(size_t i = 0; i < n; ++i)
+    {
+      e.m_boe |= uint64_t(boe(v[first + i], j)) << i;
+      e.m_woe |= uint64_t(boe(j, v[first + i])) << i;
+    }
+
+  return e;
+}
+
+template <typename Label>
+auto
+columns(const vector<Label> &v)
+{
+  boe_columns<Label> c;
+  for(const auto &l: v)
+    c.push_back(l);
+  assert(c.size() == v.size());
+  return c;
+}
+
+// The kernels for CU or SU that the CPU we run on has.
+vector<boe_kernel>
+kernels(bool su)
+{
+  vector<boe_kernel> ks = {su ? su_kernel_scalar : boe_kernel_scalar};
+#if defined(__x86_64__) && defined(__GNUC__)
+  if (__builtin_cpu_supports("avx2"))
+    ks.push_back(su ? su_kernel_avx2 : boe_kernel_avx2);
+  if (__builtin_cpu_supports("avx512f"))
+    ks.push_back(su ? su_kernel_avx512 : boe_kernel_avx512);
+#endif
+  return ks;
+}
+
+// The CU kernels should give the masks of boe, for any batch of the
+// columns.
+void
+test_cu_kernels()
+{
+  mt19937 gen(1);
+
+  for(size_t n = 1; n <= 200; ++n)
+    {
+      auto v = random_labels(n, gen);
+      auto j = random_labels(1, gen).front();
+      auto c = columns(v);
+      auto at = [&v](size_t i) -> const robed_label & {return v[i];};
+
+      for(size_t first = 0; first < n; first += boe_group)
+        {
+          auto m = min<size_t>(64, n - first);
+          auto e = expected(v, first, m, j);
+          auto f = boe_columns<robed_label>::fields(j);
+
+          for(auto k: kernels(false))
+            {
+              auto r = k(boe_lanes<3>(c.data(), first, 0), m, f.data());
+              assert(r.m_boe == e.m_boe);
+              assert(r.m_woe == e.m_woe);
+            }
+
+          auto r = boe_batch(c, first, m, j, at);
+          assert(r.m_boe == e.m_boe);
+          assert(r.m_woe == e.m_woe);
+        }
+    }
+}
+
+// The SU kernels should give the candidates, i.e., more bits than
+// boe, and boe_batch should give the masks of boe.
+void
+test_su_kernels()
+{
+  mt19937 gen(2);
+
+  for(size_t n = 1; n <= 200; ++n)
+    {
+      auto v = random_su_labels(n, gen);
+      auto j = random_su_labels(1, gen).front();
+      auto c = columns(v);
+      auto at = [&v](size_t i) -> const su_robed_label & {return v[i];};
+
+      for(size_t first = 0; first < n; first += boe_group)
+        {
+          auto m = min<size_t>(64, n - first);
+          auto e = expected(v, first, m, j);
+          auto f = boe_columns<su_robed_label>::fields(j);
+          boe_masks s;
+
+          for(auto k: kernels(true))
+            {
+              auto r = k(boe_lanes<5>(c.data(), first, 0), m, f.data());
+              assert((r.m_boe & e.m_boe) == e.m_boe);
+              assert((r.m_woe & e.m_woe) == e.m_woe);
+              // Every kernel gives the same candidates.
+              if (k != su_kernel_scalar)
+                assert(r.m_boe == s.m_boe && r.m_woe == s.m_woe);
+              s = r;
+            }
+
+          auto r = boe_batch(c, first, m, j, at);
+          assert(r.m_boe == e.m_boe);
+          assert(r.m_woe == e.m_woe);
+        }
+    }
+
+  // The span of i includes the span of j, and bit 0 of the folded
+  // bitmaps stands for both [0, 1) and [256, 257), and so the kernel
+  // finds a candidate, but boe does not.
+  vector<su_robed_label> v =
+    {su_robed_label(su_label(1, SU{CU(0, 1), CU(300, 301)}), 0)};
+  su_robed_label j(su_label(2, SU{CU(256, 257)}), 0);
+  auto c = columns(v);
+  auto f = boe_columns<su_robed_label>::fields(j);
+  assert(su_kernel_scalar(c.data(), 1, f.data()).m_boe == 1);
+  assert(boe_batch(c, 0, 1, j, [&v](size_t i) -> const auto &
+  {
+    return v[i];
+  }).m_boe == 0);
+}
+
+// The columns should follow the labels that are moved and popped, and
+// boe_any should tell what boe does.
+template <typename Label, typename Random>
+void
+test_any(Random random)
+{
+  mt19937 gen(3);
+
+  for(size_t n = 0; n <= 200; ++n)
+    {
+      auto v = random(n, gen, 1);
+      auto j = random(1, gen, 1).front();
+      auto c = columns(v);
+
+      // Remove every third label, and put the last one in its place,
+      // as generic_tentative does.
+      for(size_t i = 0; i < v.size(); i += 3)
+        {
+          c.move(v.size() - 1, i);
+          c.pop_back();
+          v[i] = v.back();
+          v.pop_back();
+        }
+      assert(c.size() == v.size());
+
+      bool e = any_of(v.begin(), v.end(), [&j](const auto &i)
+      {
+        return boe(i, j);
+      });
+
+      assert(boe_any(c, v.size(), j, [&v](size_t i) -> const Label &
+      {
+        return v[i];
+      }) == e);
+    }
+}
+
+// The tentative labels with the columns should keep the labels that
+// boe keeps, and pop them in the order of <, and they should know the
+// slots of their labels.
+template <typename Label, typename Random>
+void
+test_tentative(Random random)
+{
+  static_assert(generic_tentative<Label>::columnar);
+  mt19937 gen(4);
+
+  for(int k = 0; k < 100; ++k)
+    {
+      const unsigned keys = 3;
+      generic_tentative<Label> T(keys);
+      // The labels of every key, kept with boe.
+      vector<vector<Label>> e(keys);
+
+      for(const auto &l: random(200, gen, keys))
+        {
+          auto &ek = e[get_key(l)];
+          bool b = any_of(ek.begin(), ek.end(), [&l](const auto &i)
+          {
+            return boe(i, l);
+          });
+          assert(has_better_or_equal(T, l) == b);
+
+          if (!b)
+            {
+              erase_if(ek, [&l](const auto &i){return boe(l, i);});
+              ek.push_back(l);
+              T.push(l);
+            }
+
+          // Sometimes we pop.
+          if (gen() % 4 == 0 && !T.empty())
+            {
+              auto p = T.pop();
+              auto &ep = e[get_key(p)];
+              assert(min_element(ep.begin(), ep.end()) != ep.end());
+              assert(*min_element(ep.begin(), ep.end()) == p);
+              erase(ep, p);
+            }
+
+          for(unsigned key = 0; key < keys; ++key)
+            {
+              assert(T[key].size() == e[key].size());
+
+              // The slots of the labels are where their iterators are.
+              const auto &its = T.m_slots[key].m_its;
+              for(size_t k = 0; k < its.size(); ++k)
+                assert(T.m_slot_of.at(&*its[k]) == k);
+            }
+          assert(T.m_slot_of.size() == T.label_count());
+        }
+
+      for(; !T.empty(); T.pop());
+    }
+}
+
+int
+main()
+{
+  test_cu_kernels();
+  test_su_kernels();
+  test_any<robed_label>(random_labels);
+  test_any<su_robed_label>(random_su_labels);
+  test_tentative<robed_label>(random_labels);
+  test_tentative<su_robed_label>(random_su_labels);
+}
@@ -0,0 +1,203 @@
+#include "generic_bounds.hpp"
+#include "generic_boe_batch.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+// The label that counts its hops.
+struct hop_label: generic_hop_label<unsigned, CU>, key<unsigned>
+{
+  using label_type = generic_hop_label<unsigned, CU>;
+
+  const edge *m_edge;
+
+  hop_label(const label_type &l, const edge &e):
+    label_type(l), key<unsigned>(get_key(get_target(e))), m_edge(&e)
+  {
+  }
+
+  bool operator == (const hop_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l);
+  }
+
+  auto operator <=> (const hop_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+inline const edge &
+get_edge(const hop_label &l)
+{
+  return *l.m_edge;
+}
+
+struct hop_functor
+{
+  std::vector<hop_label>
+  operator()(const hop_label &l, const edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty())
+      return {};
+
+    return {hop_label({w, r, get_hops(l) + 1}, e)};
+  }
+};
+
+static_assert(cu_batchable<label>);
+static_assert(!cu_batchable<hop_label>);
+
+void
+test_hop_label()
+{
+  using L = generic_hop_label<unsigned, CU>;
+
+  // Fewer hops do not make a label less, unless the weights and the
+  // resources are equal.
+  assert(L(1, CU(0, 2), 5) < L(2, CU(0, 2), 1));
+  assert(L(1, CU(0, 2), 1) < L(1, CU(0, 2), 2));
+  assert(boe(L(1, CU(0, 2), 1), L(1, CU(0, 2), 2)));
+  assert(!boe(L(1, CU(0, 2), 2), L(1, CU(0, 2), 1)));
+  assert(!boe(L(1, CU(0, 2), 2), L(2, CU(0, 1), 1)));
+}
+
+// With the weight limit, the search yields the labels of the search
+// without it, up to the limit, and makes no more labels permanent.
+void
+test_weight()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      const unsigned dst = 19;
+      edge ie(g[0], g[0], 0, CU(0, 9));
+      label initial({0, CU(0, 9)}, ie);
+
+      generic_permanent<label> P1(g.size());
+      generic_tentative<label> T1(g.size());
+      std::vector<label> ls1;
+      for(const auto &l: generic_search(P1, T1, functor(), initial, dst))
+        if (get_weight(l) <= 15)
+          ls1.push_back(l);
+
+      bounded_functor f(functor(), search_bounds<unsigned>{15});
+      generic_permanent<label> P2(g.size());
+      generic_tentative<label> T2(g.size());
+      std::vector<label> ls2;
+      for(const auto &l: generic_search(P2, T2, f, initial, dst))
+        {
+          ls2.push_back(l);
+
+          // The bounded functor gives the paths too.
+          unsigned w = 0;
+          for(const auto &pl: generic_path_range(P2, f, l, initial))
+            w += get_weight(get_edge(pl));
+          assert(w == get_weight(l));
+        }
+
+      assert(ls1 == ls2);
+
+      std::size_t n1 = 0, n2 = 0;
+      for(unsigned i = 0; i < g.size(); ++i)
+        {
+          n1 += P1[i].size();
+          n2 += P2[i].size();
+        }
+      assert(n2 <= n1);
+    }
+}
+
+// The labels of all paths from vertex v to dst of at most hops edges,
+// with weight w and resources r so far.
+void
+all_paths(const std::deque<vertex> &g, unsigned v, unsigned dst,
+          unsigned hops, unsigned w, CU r, std::vector<label> &ls)
+{
+  if (v == dst)
+    {
+      ls.push_back(label({w, r}, get_edge(ls.front())));
+      return;
+    }
+
+  if (!hops)
+    return;
+
+  for(const auto &e: g[v].m_edges)
+    if (auto c = intersection(r, get_resources(e)); !c.empty())
+      all_paths(g, get_key(get_target(e)), dst, hops - 1,
+                w + get_weight(e), c, ls);
+}
+
+// The boe-incomparable labels of ls, sorted with <, without their
+// hops.
+template <typename Label>
+std::vector<generic_label<unsigned, CU>>
+front(const std::vector<Label> &ls)
+{
+  std::vector<generic_label<unsigned, CU>> s(ls.begin(), ls.end());
+  std::ranges::stable_sort(s);
+
+  std::vector<generic_label<unsigned, CU>> f;
+  for(const auto &l: s)
+    if (!boe(f, l))
+      f.push_back(l);
+
+  return f;
+}
+
+// With the hop limit, the search finds the paths of all paths of at
+// most as many hops.
+void
+test_hops()
+{
+  std::mt19937 gen(1);
+
+  for(unsigned hops = 1; hops <= 5; ++hops)
+    for(int k = 0; k < 20; ++k)
+      {
+        auto g = random_graph(10, 30, gen);
+        const unsigned dst = 9;
+        edge ie(g[0], g[0], 0, CU(0, 9));
+
+        // The first label has the edge for the others.
+        std::vector<label> all{label({0, CU(0, 9)}, ie)};
+        all_paths(g, 0, dst, hops, 0, CU(0, 9), all);
+        all.erase(all.begin());
+
+        hop_label initial({0, CU(0, 9), 0}, ie);
+        bounded_functor f(hop_functor(), search_bounds<unsigned>{.m_max_hops
+                                                                 = hops});
+        generic_permanent<hop_label> P(g.size());
+        generic_tentative<hop_label> T(g.size());
+        std::vector<hop_label> ls;
+        for(const auto &l: generic_search(P, T, f, initial, dst))
+          {
+            assert(get_hops(l) <= hops);
+            ls.push_back(l);
+          }
+
+        assert(front(ls) == front(all));
+      }
+}
+
+int
+main()
+{
+  test_hop_label();
+  test_weight();
+  test_hops();
+}
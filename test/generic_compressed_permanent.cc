@@ -0,0 +1,182 @@
+#include "generic_compressed_permanent.hpp"
+#include "generic_pareto.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "label_robe.hpp"
+#include "test_graph.hpp"
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+using robed_label = label_robe<CU>;
+
+struct robe_codec
+{
+  compressed_fields
+  encode(const robed_label &l) const
+  {
+    return {get_weight(l), get_resources(l).min(), get_resources(l).max(),
+            0};
+  }
+
+  robed_label
+  decode(const compressed_fields &f, std::size_t key) const
+  {
+    return robed_label(robed_label::label_type(f.m_weight,
+                                               CU(f.m_min, f.m_max)), key);
+  }
+};
+
+// The numbers of any size should come back.
+void
+test_varint()
+{
+  std::vector<std::uint8_t> b;
+  std::vector<std::uint64_t> ns = {0, 1, 127, 128, 300, ~0ULL, 1ULL << 63};
+  for(auto n: ns)
+    put_varint(b, n);
+  assert(b.size() == 1 + 1 + 1 + 2 + 2 + 10 + 10);
+
+  const std::uint8_t *p = b.data();
+  for(auto n: ns)
+    assert(get_varint(p) == n);
+
+  for(std::uint64_t a: {0ULL, 5ULL, ~0ULL})
+    for(std::uint64_t c: {0ULL, 3ULL, 7ULL, ~0ULL})
+      assert(unzigzag(c, zigzag(a, c)) == a);
+  assert(zigzag(4, 5) == 1);
+  assert(zigzag(5, 4) == 2);
+}
+
+// The compressed labels should be the labels, and
+// has_better_or_equal should say what it says for the labels.
+void
+test_labels()
+{
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<unsigned> wd(0, 1000), ud(0, 100);
+  std::uniform_int_distribution<unsigned> kd(0, 9);
+
+  // The labels of a key are sorted with <, and boe-incomparable.
+  generic_pareto<robed_label> P(10);
+  for(int i = 0; i < 2000; ++i)
+    {
+      unsigned a = ud(gen), b = ud(gen);
+      if (a > b)
+        std::swap(a, b);
+      P.insert(robed_label({wd(gen), CU(a, b + 1)}, kd(gen)));
+    }
+
+  // Blocks of 4 labels, so that there are many.
+  generic_compressed_permanent<robed_label, robe_codec, 4> C(P);
+  assert(C.size() == P.size());
+
+  std::size_t count = 0;
+  for(std::size_t k = 0; k < P.size(); ++k)
+    {
+      const auto &vd = P[k];
+      count += vd.size();
+      assert(C[k].size() == vd.size());
+
+      std::vector<robed_label> ls;
+      for(const auto &l: C[k])
+        ls.push_back(l);
+      assert(ls == vd);
+
+      for(std::size_t n = 0; n <= vd.size(); ++n)
+        {
+          auto r = C.from(k, n);
+          assert(r.size() == vd.size() - n);
+          if (n < vd.size())
+            assert(*r.begin() == vd[n]);
+        }
+    }
+  assert(C.label_count() == count);
+
+  for(int i = 0; i < 2000; ++i)
+    {
+      unsigned a = ud(gen), b = ud(gen);
+      if (a > b)
+        std::swap(a, b);
+      robed_label j({wd(gen), CU(a, b + 1)}, kd(gen));
+      assert(has_better_or_equal(C, j) == has_better_or_equal(P, j));
+    }
+}
+
+// The edges are encoded with their keys, and the initial edge with
+// the number of edges.
+struct edge_codec
+{
+  std::vector<const edge *> m_edges;
+
+  compressed_fields
+  encode(const label &l) const
+  {
+    auto k = get_key(get_edge(l));
+    return {get_weight(l), get_resources(l).min(), get_resources(l).max(),
+            k == ~0U ? m_edges.size() - 1 : k};
+  }
+
+  label
+  decode(const compressed_fields &f, std::size_t) const
+  {
+    return label({unsigned(f.m_weight), CU(f.m_min, f.m_max)},
+                 *m_edges[f.m_edge]);
+  }
+};
+
+// The paths traced in the compressed labels should be the paths
+// traced in the labels.
+void
+test_paths()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      const unsigned src = 0, dst = 19;
+      edge ie(g[src], g[src], 0, CU(0, 9));
+      label initial({0, CU(0, 9)}, ie);
+      functor f;
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      for([[maybe_unused]] const auto &l:
+            generic_search(P, T, f, initial, dst))
+        ;
+
+      edge_codec c;
+      for(const auto &v: g)
+        for(const auto &e: v.m_edges)
+          c.m_edges.push_back(&e);
+      std::ranges::sort(c.m_edges, {}, [](auto e){return get_key(*e);});
+      c.m_edges.push_back(&ie);
+
+      generic_compressed_permanent<label, edge_codec> C(P, c);
+
+      for(const auto &l: P[dst])
+        {
+          std::vector<const edge *> p1, p2;
+
+          for(const auto &pl: generic_path_range(P, f, l, initial))
+            p1.push_back(&get_edge(pl));
+          for(const auto &pl: generic_path_range(C, f, l, initial))
+            p2.push_back(&get_edge(pl));
+
+          assert(!p1.empty());
+          assert(p1 == p2);
+        }
+    }
+}
+
+int
+main()
+{
+  test_varint();
+  test_labels();
+  test_paths();
+}
@@ -0,0 +1,200 @@
+#include "generic_contraction.hpp"
+#include "generic_label.hpp"
+#include "props.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using label = generic_label<unsigned, CU>;
+
+struct vertex;
+
+struct edge: weight<unsigned>, resources<CU>, key<unsigned>
+{
+  unsigned m_source;
+  unsigned m_target;
+
+  edge(unsigned s, unsigned t, unsigned w, const CU &r, unsigned k):
+    weight<unsigned>(w), resources<CU>(r), key<unsigned>(k),
+    m_source(s), m_target(t)
+  {
+  }
+};
+
+struct vertex: key<unsigned>
+{
+  std::vector<edge> m_edges;
+
+  vertex(unsigned k): key<unsigned>(k)
+  {
+  }
+};
+
+// The graph: the targets of edges are looked up in the graph.
+struct graph: std::vector<vertex>
+{
+  std::vector<edge *> m_edges;
+
+  graph(unsigned count, unsigned edges, std::mt19937 &gen)
+  {
+    for(unsigned i = 0; i < count; ++i)
+      emplace_back(i);
+
+    std::uniform_int_distribution<unsigned> vd(0, count - 1), wd(1, 10);
+    std::uniform_int_distribution<unsigned> ud(0, 8);
+
+    for(unsigned k = 0; k < edges; ++k)
+      {
+        unsigned s = vd(gen), t = vd(gen);
+        unsigned a = ud(gen), b = ud(gen);
+        if (a > b)
+          std::swap(a, b);
+        at(s).m_edges.emplace_back(s, t, wd(gen), CU(a, b + 1), k);
+      }
+
+    for(auto &v: *this)
+      for(auto &e: v.m_edges)
+        m_edges.push_back(&e);
+    std::ranges::sort(m_edges, {}, [](auto e){return get_key(*e);});
+  }
+};
+
+// The graph is a global, so that get_target can look up the vertex.
+const graph *g_graph;
+
+const vertex &
+get_target(const edge &e)
+{
+  return (*g_graph)[e.m_target];
+}
+
+const auto &
+get_edges(const vertex &v)
+{
+  return v.m_edges;
+}
+
+// The boe-incomparable labels of all paths from src to dst, sorted
+// with <, found by going through all paths of at most count edges.
+std::vector<label>
+brute(const graph &g, unsigned src, unsigned dst)
+{
+  std::vector<label> ls;
+
+  auto dfs = [&](auto &self, unsigned v, const label &l,
+                 unsigned depth) -> void
+  {
+    if (v == dst && depth)
+      {
+        if (std::ranges::none_of(ls, [&](const auto &i){return boe(i, l);}))
+          {
+            std::erase_if(ls, [&](const auto &i){return boe(l, i);});
+            ls.push_back(l);
+          }
+        return;
+      }
+
+    if (depth == g.size())
+      return;
+
+    for(const auto &e: g[v].m_edges)
+      {
+        auto r = intersection(get_resources(l), get_resources(e));
+        if (!r.empty() && e.m_target != e.m_source)
+          self(self, e.m_target, label(get_weight(l) + get_weight(e), r),
+               depth + 1);
+      }
+  };
+
+  dfs(dfs, src, label(0, CU(0, 9)), 0);
+  std::ranges::sort(ls);
+
+  return ls;
+}
+
+// The query should find the labels of the brute force, and the
+// unpacked paths should have these labels.
+void
+check(const graph &g, const generic_cch<unsigned, CU> &cch)
+{
+  auto fits = [](const CU &){return true;};
+
+  for(unsigned s = 0; s < g.size(); ++s)
+    for(unsigned t = 0; t < g.size(); ++t)
+      {
+        if (s == t)
+          continue;
+
+        auto result = cch_query(cch, s, t, CU(0, 9), fits);
+        auto expected = brute(g, s, t);
+
+        assert(result.m_labels.size() == expected.size());
+
+        for(std::size_t i = 0; i < expected.size(); ++i)
+          {
+            const auto &l = result.m_labels[i];
+            assert(static_cast<const label &>(l) == expected[i]);
+
+            // The path goes from s to t, and has the label.
+            label pl(0, CU(0, 9));
+            unsigned v = s;
+            for(auto k: result.unpack(cch, l))
+              {
+                const auto &e = *g.m_edges[k];
+                assert(e.m_source == v);
+                pl = label(get_weight(pl) + get_weight(e),
+                           intersection(get_resources(pl),
+                                        get_resources(e)));
+                v = e.m_target;
+              }
+            assert(v == t);
+            assert(pl == l);
+          }
+      }
+}
+
+void
+test_query()
+{
+  std::mt19937 gen(1);
+
+  for(int n = 0; n < 10; ++n)
+    {
+      graph g(6, 14, gen);
+      g_graph = &g;
+
+      auto neighbours = [&](std::size_t v)
+      {
+        std::vector<std::size_t> ns;
+        for(const auto &e: g[v].m_edges)
+          ns.push_back(e.m_target);
+        return ns;
+      };
+
+      generic_cch<unsigned, CU> cch(g, min_degree_order(g.size(),
+                                                        neighbours));
+      check(g, cch);
+
+      // Some resources change, and the hierarchy is customized again.
+      std::uniform_int_distribution<unsigned> ed(0, g.m_edges.size() - 1);
+      for(int i = 0; i < 3; ++i)
+        {
+          auto &e = *g.m_edges[ed(gen)];
+          auto r = get_resources(e);
+          e = edge(e.m_source, e.m_target, get_weight(e),
+                   CU(r.min(), r.min() + 1), get_key(e));
+          cch.update(e);
+        }
+      cch.customize();
+      check(g, cch);
+    }
+}
+
+int
+main()
+{
+  test_query();
+}
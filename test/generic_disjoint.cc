@@ -0,0 +1,202 @@
+#include "generic_disjoint.hpp"
+#include "test_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using path = std::vector<const edge *>;
+
+// The trap: the shortest path 0-1-2-3 leaves no second path, but the
+// pair 0-1-3 and 0-2-3 is there.
+std::deque<vertex>
+trap(const CU &r01, const CU &r13, const CU &r02, const CU &r23)
+{
+  std::deque<vertex> g;
+  for(unsigned i = 0; i < 4; ++i)
+    g.emplace_back(i);
+
+  g[0].m_edges.emplace_back(g[0], g[1], 1, r01, 0);
+  g[1].m_edges.emplace_back(g[1], g[2], 1, CU(0, 8), 1);
+  g[2].m_edges.emplace_back(g[2], g[3], 1, r23, 2);
+  g[0].m_edges.emplace_back(g[0], g[2], 2, r02, 3);
+  g[1].m_edges.emplace_back(g[1], g[3], 2, r13, 4);
+
+  return g;
+}
+
+void
+test_trap()
+{
+  {
+    auto g = trap(CU(0, 8), CU(0, 8), CU(0, 8), CU(0, 8));
+    auto ps = generic_approx_disjoint_pairs(g, 0, 3, CU(0, 8), 1);
+    assert(ps.size() == 1);
+    assert(ps[0].m_weight == 6);
+    assert(ps[0].m_paths[0].m_edges.size() == 2);
+    assert(ps[0].m_paths[1].m_edges.size() == 2);
+    assert(ps[0].m_paths[0].m_resources == CU(0, 8));
+  }
+
+  // Each path has its own resources.
+  {
+    auto g = trap(CU(0, 4), CU(0, 4), CU(4, 8), CU(4, 8));
+    auto ps = generic_approx_disjoint_pairs(g, 0, 3, CU(0, 8), 2);
+    assert(ps.size() == 1);
+    assert(ps[0].m_weight == 6);
+    const auto &[p0, p1] = ps[0].m_paths;
+    assert((p0.m_resources == CU(0, 4) && p1.m_resources == CU(4, 8)) ||
+           (p0.m_resources == CU(4, 8) && p1.m_resources == CU(0, 4)));
+  }
+
+  // A path cannot fit the width.
+  {
+    auto g = trap(CU(0, 4), CU(0, 4), CU(4, 5), CU(4, 8));
+    auto ps = generic_approx_disjoint_pairs(g, 0, 3, CU(0, 8), 2);
+    assert(ps.empty());
+  }
+}
+
+// The path of a label whose preceding label is not there cannot be
+// traced.
+void
+test_no_path()
+{
+  auto g = trap(CU(0, 8), CU(0, 8), CU(0, 8), CU(0, 8));
+  edge ie(g[0], g[0], 0, CU(0, 8));
+  label initial({0, CU(0, 8)}, ie);
+  functor f;
+
+  // The label of vertex 2 that came from vertex 1, but vertex 1 has
+  // no labels.
+  const auto &e12 = g[1].m_edges.front();
+  generic_permanent<label> P(g.size());
+  P.push(initial);
+  const auto &l = P.push(label({2, CU(0, 8)}, e12));
+
+  bool thrown = false;
+  try
+    {
+      residual_path(P, f, l, initial);
+    }
+  catch (const std::runtime_error &)
+    {
+      thrown = true;
+    }
+  assert(thrown);
+}
+
+// All simple paths from vertex v to vertex dst.
+void
+all_paths(const std::deque<vertex> &g, unsigned v, unsigned dst,
+          std::vector<bool> &seen, path &p, std::vector<path> &ps)
+{
+  if (v == dst)
+    {
+      ps.push_back(p);
+      return;
+    }
+
+  seen[v] = true;
+  for(const auto &e: g[v].m_edges)
+    if (!seen[get_key(get_target(e))])
+      {
+        p.push_back(&e);
+        all_paths(g, get_key(get_target(e)), dst, seen, p, ps);
+        p.pop_back();
+      }
+  seen[v] = false;
+}
+
+// The returned pairs are edge-disjoint paths from the source to the
+// target whose weights and resources are right, and no pair is better
+// than or equal to another.  With no resources in use, the lightest
+// pair is the lightest of all.
+void
+test_random(unsigned width, bool free)
+{
+  std::mt19937 gen(1);
+  const CU r(0, 9);
+
+  for(int k = 0; k < 200; ++k)
+    {
+      auto g = random_graph(8, 24, gen);
+      if (free)
+        for(auto &v: g)
+          for(auto &e: v.m_edges)
+            e = edge(get_source(e), get_target(e), get_weight(e), r,
+                     get_key(e));
+
+      const unsigned src = 0, dst = 7;
+      auto ps = generic_approx_disjoint_pairs(g, src, dst, r, width);
+
+      for(const auto &p: ps)
+        {
+          unsigned w = 0;
+          for(const auto &dp: p.m_paths)
+            {
+              unsigned pw = 0, v = src;
+              CU pr = r;
+              for(const auto *e: dp.m_edges)
+                {
+                  assert(get_key(get_source(*e)) == v);
+                  v = get_key(get_target(*e));
+                  pw += get_weight(*e);
+                  pr = intersection(pr, get_resources(*e));
+                }
+              assert(v == dst);
+              assert(pw == dp.m_weight);
+              assert(pr == dp.m_resources);
+              assert(pr.max() - pr.min() >= width);
+              w += pw;
+            }
+          assert(w == p.m_weight);
+
+          for(const auto *e: p.m_paths[0].m_edges)
+            assert(std::ranges::find(p.m_paths[1].m_edges, e) ==
+                   p.m_paths[1].m_edges.end());
+
+          for(const auto &q: ps)
+            assert(&p == &q || !boe(p, q));
+        }
+
+      // The lightest pair by brute force.
+      std::vector<path> aps;
+      std::vector<bool> seen(g.size());
+      path p;
+      all_paths(g, src, dst, seen, p, aps);
+
+      unsigned best = ~0U;
+      for(const auto &a: aps)
+        for(const auto &b: aps)
+          if (&a < &b &&
+              std::ranges::none_of(a, [&b](const auto *e)
+              {
+                return std::ranges::find(b, e) != b.end();
+              }))
+            {
+              auto pa = make_disjoint_path(a, r, width);
+              auto pb = make_disjoint_path(b, r, width);
+              if (pa && pb)
+                best = std::min(best, pa->m_weight + pb->m_weight);
+            }
+
+      if (free)
+        assert(best == (ps.empty() ? ~0U : ps[0].m_weight));
+      else
+        assert(ps.empty() || best <= ps[0].m_weight);
+    }
+}
+
+int
+main()
+{
+  test_trap();
+  test_no_path();
+  test_random(1, true);
+  test_random(1, false);
+  test_random(3, false);
+}
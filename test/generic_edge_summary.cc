@@ -0,0 +1,111 @@
+#include "generic_edge_summary.hpp"
+#include "generic_label.hpp"
+#include "props.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+using label = generic_label<unsigned, CU>;
+
+struct edge: weight<unsigned>, resources<CU>, key<unsigned>
+{
+  edge(unsigned w, const CU &r, unsigned k):
+    weight<unsigned>(w), resources<CU>(r), key<unsigned>(k)
+  {
+  }
+};
+
+void
+test_largest_run()
+{
+  assert(largest_run(CU()) == 0);
+  assert(largest_run(CU(2, 5)) == 3);
+  assert(largest_run(SU{{0, 1}, {3, 7}, {8, 10}}) == 4);
+}
+
+// The summaries must never reject resources that have a run of the
+// width in common, for blocks of one unit, and of a few units.
+void
+test_may_fit()
+{
+  for(unsigned units: {16, 100})
+    {
+      unsigned block = (units + 63) / 64;
+
+      for(unsigned a = 0; a < 16; ++a)
+        for(unsigned b = a + 1; b <= 16; ++b)
+          for(unsigned c = 0; c < 16; ++c)
+            for(unsigned d = c + 1; d <= 16; ++d)
+              for(unsigned w = 1; w < 4; ++w)
+                {
+                  CU i = intersection(CU(a, b), CU(c, d));
+                  bool fits = largest_run(i) >= w;
+                  bool may = may_fit(summarize(CU(a, b), block),
+                                     summarize(CU(c, d), block), w);
+                  assert(!fits || may);
+                  // For blocks of one unit, the summaries tell exactly
+                  // whether the intersection is empty.
+                  if (block == 1 && w == 1)
+                    assert(fits == may);
+                }
+    }
+}
+
+// The units past the 64 blocks go to the last block, and the
+// summaries still never reject the resources that intersect.
+void
+test_past_blocks()
+{
+  assert(summary_blocks(70, 80, 1) == std::uint64_t(1) << 63);
+  assert(summary_blocks(10, 200, 1) == ~((std::uint64_t(1) << 10) - 1));
+
+  for(unsigned a = 0; a < 100; a += 7)
+    for(unsigned b = a + 1; b <= 100; b += 5)
+      for(unsigned c = 0; c < 100; c += 3)
+        for(unsigned d = c + 1; d <= 100; d += 11)
+          {
+            bool fits = !intersection(CU(a, b), CU(c, d)).empty();
+            assert(!fits || may_fit(summarize(CU(a, b), 1),
+                                    summarize(CU(c, d), 1), 1));
+          }
+}
+
+// The creator rejects what the summaries reject, and otherwise
+// produces the candidate of generic_label_creator.
+void
+test_creator()
+{
+  generic_edge_summaries s(2, 16);
+  edge e0(1, CU(1, 3), 0), e1(1, CU(6, 16), 1);
+  s.update(e0);
+  s.update(e1);
+
+  generic_summary_creator c(s, 3);
+  label l(1, CU(2, 10));
+
+  // Edge 0 has two units only, so it is rejected before the
+  // intersection.
+  assert(c(l, e0).second.empty());
+  assert(c(l, e1) == generic_label_creator()(l, e1));
+
+  // The creator of the relaxations of l produces the same.
+  auto cl = c.for_label(l);
+  assert(cl(e0).second.empty());
+  assert(cl(e1) == c(l, e1));
+
+  // The resources of edge 0 change.
+  e0 = edge(1, CU(0, 8), 0);
+  s.update(e0);
+  assert(c(l, e0) == generic_label_creator()(l, e0));
+  assert(cl(e0) == c(l, e0));
+}
+
+int
+main()
+{
+  test_largest_run();
+  test_may_fit();
+  test_past_blocks();
+  test_creator();
+}
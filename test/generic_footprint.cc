@@ -0,0 +1,173 @@
+#include "generic_footprint.hpp"
+#include "generic_permanent.hpp"
+#include "generic_permanent2.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "label_robe.hpp"
+#include "test_graph.hpp"
+
+#include <cassert>
+#include <random>
+#include <sstream>
+
+using robed_label = label_robe<CU>;
+using rlabel = robed_label::label_type;
+
+// The footprint should count the labels, the keys by the number of
+// their labels, and the bytes of vectors and sets.
+void
+test_footprint()
+{
+  generic_permanent<robed_label> P(3);
+  P.push(robed_label(rlabel(1, {0, 2}), 0));
+  P.push(robed_label(rlabel(2, {0, 3}), 0));
+  P.push(robed_label(rlabel(3, {0, 4}), 0));
+  P.push(robed_label(rlabel(1, {0, 2}), 2));
+
+  auto f = footprint(P);
+  assert(f.m_keys == 3);
+  assert(f.m_labels == 4);
+  assert(f.m_peak_labels == 4);
+  assert(f.m_max_labels == 3);
+  assert(f.m_histogram[0] == 1);
+  assert(f.m_histogram[1] == 1);
+  assert(f.m_histogram[2] == 1);
+  // The keys have too few labels for columns, but there is the
+  // vector of them.
+  std::size_t side = P.m_columns.capacity() * sizeof(P.m_columns[0]);
+  assert(f.m_side_bytes == side);
+  std::size_t bytes = P.capacity() * sizeof(P[0]) +
+    (P[0].capacity() + P[2].capacity()) * sizeof(robed_label) + side;
+  assert(f.m_bytes == bytes);
+  assert(f.m_slack_bytes == (P[0].capacity() - 3 + P[2].capacity() - 1)
+         * sizeof(robed_label));
+
+  // A key of enough labels has the columns of whole groups.
+  generic_permanent<robed_label> C(1);
+  for(unsigned i = 0; i < 20; ++i)
+    C.push(robed_label(rlabel(i, {i, i + 2}), 0));
+  auto fc = footprint(C);
+  assert(fc.m_side_bytes == C.m_columns.capacity() * sizeof(C.m_columns[0])
+         + 2 * boe_group * footprint_column_bytes<robed_label>());
+  assert(fc.m_bytes == C.capacity() * sizeof(C[0]) +
+         C[0].capacity() * sizeof(robed_label) + fc.m_side_bytes);
+
+  // The labels inline in small vectors take no bytes of their own.
+  generic_small_permanent<robed_label, 2> S(2);
+  S.push(robed_label(rlabel(1, {0, 2}), 0));
+  S.push(robed_label(rlabel(1, {0, 2}), 1));
+  S.push(robed_label(rlabel(2, {0, 3}), 1));
+  S.push(robed_label(rlabel(3, {0, 4}), 1));
+  auto fs = footprint(S);
+  assert(fs.m_labels == 4);
+  assert(fs.m_side_bytes == S.m_columns.capacity() * sizeof(S.m_columns[0]));
+  assert(fs.m_bytes == S.capacity() * sizeof(S[0]) +
+         S[1].capacity() * sizeof(robed_label) + fs.m_side_bytes);
+
+  // The labels in sets take a node each.
+  generic_permanent2<robed_label> P2(2);
+  P2.push(robed_label(rlabel(1, {0, 2}), 0));
+  P2.push(robed_label(rlabel(2, {0, 3}), 0));
+  auto f2 = footprint(P2);
+  assert(f2.m_labels == 2);
+  assert(f2.m_slack_bytes == 0);
+  // The first key has the columns of a group, and the pointers to
+  // its labels.
+  assert(f2.m_side_bytes == P2.m_slots.capacity() * sizeof(P2.m_slots[0])
+         + boe_group * footprint_column_bytes<robed_label>() +
+         P2.m_slots[0].m_ls.capacity() * sizeof(const robed_label *));
+  assert(f2.m_bytes == P2.capacity() * sizeof(P2[0]) +
+         2 * footprint_node_bytes<robed_label>() + f2.m_side_bytes);
+
+  // The tentative labels have also the keys in the queue.
+  generic_tentative<robed_label> T(2);
+  T.push(robed_label(rlabel(1, {0, 2}), 0));
+  T.push(robed_label(rlabel(2, {0, 3}), 0));
+  T.push(robed_label(rlabel(2, {0, 3}), 1));
+  auto ft = footprint(T);
+  assert(ft.m_labels == 3);
+  // Both keys have the columns of a group, the iterators to their
+  // labels, and the slots of the labels.
+  using slot_type = decltype(T.m_slot_of)::value_type;
+  std::size_t tside = T.m_slots.capacity() * sizeof(T.m_slots[0]) +
+    2 * boe_group * footprint_column_bytes<robed_label>() +
+    (T.m_slots[0].m_its.capacity() + T.m_slots[1].m_its.capacity()) *
+    sizeof(T.m_slots[0].m_its[0]) +
+    3 * footprint_hash_node_bytes<slot_type>() +
+    T.m_slot_of.bucket_count() * sizeof(void *);
+  assert(ft.m_side_bytes == tside);
+  assert(ft.m_bytes == T.capacity() * sizeof(T[0]) +
+         3 * footprint_node_bytes<robed_label>() +
+         2 * footprint_node_bytes<std::size_t>() + tside);
+
+  // The estimate of memory_limit_probe counts the side data too, but
+  // not the unused lanes of the columns, or the slack of vectors.
+  assert(footprint_estimate(T, 3) <= ft.m_bytes);
+  assert(footprint_estimate(T, 3) > ft.m_bytes - ft.m_side_bytes);
+  assert(footprint_estimate(P2, 2) <= f2.m_bytes);
+  assert(footprint_estimate(P2, 2) > f2.m_bytes - f2.m_side_bytes);
+
+  // The tentative labels remember their peak.
+  T.pop();
+  T.pop();
+  ft = footprint(T);
+  assert(ft.m_labels == 1);
+  assert(ft.m_peak_labels == 3);
+
+  std::ostringstream out;
+  out << f;
+  assert(out.str() == "keys = 3, labels = 4, peak labels = 4, "
+         "max labels = 3, bytes = " +
+         std::to_string(f.m_bytes) + ", slack bytes = " +
+         std::to_string(f.m_slack_bytes) + ", side bytes = " +
+         std::to_string(f.m_side_bytes) + ", histogram = 1 1 1");
+}
+
+// The search should stop when the labels take more bytes than the
+// limit, and otherwise it should find what it finds without a limit.
+void
+test_limit()
+{
+  std::mt19937 gen(1);
+  auto g = random_graph(100, 600, gen);
+  const unsigned src = 0, dst = 99;
+  edge ie(g[src], g[src], 0, CU(0, 9));
+  label initial({0, CU(0, 9)}, ie);
+  functor f;
+
+  auto search = [&](auto... probe)
+  {
+    generic_permanent<label> P(g.size());
+    generic_tentative<label> T(g.size());
+    for([[maybe_unused]] const auto &l:
+          generic_search(P, T, f, initial, dst, probe...))
+      ;
+    return footprint(P).m_labels;
+  };
+
+  auto n = search();
+
+  memory_budget b;
+  assert(search(memory_limit_probe(b)) == n);
+  assert(b.m_status == search_status::complete);
+  assert(b.m_permanent == n);
+  assert(b.m_peak_tentative > 0);
+  auto peak = b.m_peak_bytes;
+  assert(peak > 0);
+
+  b.m_limit = peak;
+  assert(search(memory_limit_probe(b)) == n);
+  assert(b.m_status == search_status::complete);
+
+  b.m_limit = peak / 2;
+  assert(search(memory_limit_probe(b)) < n);
+  assert(b.m_status == search_status::memory_limit);
+  assert(b.m_peak_bytes > b.m_limit);
+}
+
+int
+main()
+{
+  test_footprint();
+  test_limit();
+}
@@ -1,6 +1,7 @@
 #include "helpers.hpp"
 
 #include "generic_label.hpp"
+#include "generic_packed_label.hpp"
 #include "units.hpp"
 
 #include <algorithm>
@@ -9,6 +10,7 @@
 #include <vector>
 
 using label = generic_label<unsigned, CU>;
+using packed_label = generic_packed_label<unsigned, CU>;
 
 using namespace std;
 
@@ -194,6 +196,9 @@ incomparable_RIs(const CU &ri, const CU &omega)
 // Test all relations.
 // *****************************************************************
 
+// We test the relations of any label type that should behave as
+// generic_label, e.g., generic_packed_label.
+template <typename label>
 void
 test_relations()
 {
@@ -273,6 +278,7 @@ test_relations()
 // *****************************************************************
 
 // Generate labels that are worse than li.
+template <typename label>
 auto
 worse_labels(const label &li, const CU &omega)
 {
@@ -308,6 +314,7 @@ worse_labels(const label &li, const CU &omega)
   return s;
 }
 
+template <typename label>
 void
 test_transitivity()
 {
@@ -601,8 +608,10 @@ main()
   test_icl_RIs();
   test_icr_RIs();
 
-  test_relations();
-  test_transitivity();
+  test_relations<label>();
+  test_relations<packed_label>();
+  test_transitivity<label>();
+  test_transitivity<packed_label>();
   test_intran_boe_incomp();
 
   test_vector_boe_cu();
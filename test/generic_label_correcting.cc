@@ -0,0 +1,53 @@
+#include "generic_label_correcting.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+
+#include <cassert>
+#include <random>
+
+// The label-correcting search should find the labels of the target
+// that generic_search finds, in either order, and their paths should
+// lead to the source.
+void
+test_search(lc_order order)
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      const unsigned src = 0, dst = 19;
+      edge ie(g[src], g[src], 0, CU(0, 9));
+      label initial({0, CU(0, 9)}, ie);
+      functor f;
+
+      generic_permanent<label> P1(g.size());
+      generic_tentative<label> T1(g.size());
+      for([[maybe_unused]] const auto &l:
+            generic_search(P1, T1, f, initial, dst))
+        ;
+
+      generic_pareto<label> P2(g.size());
+      generic_label_correcting(P2, f, initial, dst, order);
+
+      assert(P1[dst] == P2[dst]);
+
+      for(const auto &l: P2[dst])
+        {
+          unsigned w = 0;
+          for(const auto &pl: generic_path_range(P2, f, l, P2[src][0]))
+            w += get_weight(get_edge(pl));
+          assert(w == get_weight(l));
+        }
+    }
+}
+
+int
+main()
+{
+  test_search(lc_order::fifo);
+  test_search(lc_order::slf);
+}
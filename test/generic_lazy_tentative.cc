@@ -0,0 +1,131 @@
+#include "generic_lazy_tentative.hpp"
+#include "generic_permanent.hpp"
+#include "generic_tentative.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+#include <random>
+
+using namespace std;
+
+using robed_label = label_robe<CU>;
+using label = robed_label::label_type;
+
+// The labels should be popped in the order of <, and the labels
+// dominated by the permanent labels should be purged.
+void
+test_purge()
+{
+  generic_lazy_tentative<robed_label> T(2);
+  generic_permanent<robed_label> P(2);
+
+  T.push(robed_label(label(3, {0, 2}), 0));
+  T.push(robed_label(label(1, {0, 3}), 0));
+  T.push(robed_label(label(2, {0, 1}), 1));
+  T.push(robed_label(label(2, {2, 4}), 0));
+
+  T.purge(P);
+  P.push(T.pop());
+  assert(P[0].back() == robed_label(label(1, {0, 3}), 0));
+
+  T.purge(P);
+  P.push(T.pop());
+  assert(P[1].back() == robed_label(label(2, {0, 1}), 1));
+
+  T.purge(P);
+  P.push(T.pop());
+  assert(P[0].back() == robed_label(label(2, {2, 4}), 0));
+
+  // Label(3, {0, 2}) is dominated by label(1, {0, 3}).
+  T.purge(P);
+  assert(T.empty());
+}
+
+// The compaction should remove the dominated labels of the marked keys
+// only.
+void
+test_compact()
+{
+  generic_lazy_tentative<robed_label> T(2, 2);
+
+  T.push(robed_label(label(3, {0, 2}), 0));
+  T.push(robed_label(label(3, {0, 2}), 1));
+  T.push(robed_label(label(2, {0, 3}), 0));
+  assert(T.m_heap.size() == 3);
+  // Now key 0 has three labels, and so it is marked.
+  T.push(robed_label(label(1, {2, 3}), 0));
+  assert(T.m_heap.size() == 4);
+  assert(T.m_marked[0] && !T.m_marked[1]);
+
+  // The marked key has two of the three labels left, and so it is
+  // compacted.
+  assert(T.pop() == robed_label(label(1, {2, 3}), 0));
+  assert(T.m_heap.size() == 2);
+  assert(T.m_pending[0] == 1);
+  assert(!T.m_marked[0]);
+
+  assert(T.pop() == robed_label(label(2, {0, 3}), 0));
+  assert(T.pop() == robed_label(label(3, {0, 2}), 1));
+  assert(T.empty());
+}
+
+// The lazy labels should become permanent as the eager ones do, when
+// the labels are pushed as in the search, i.e., no lighter than the
+// last permanent label.
+void
+test_eager()
+{
+  std::mt19937 gen(1);
+  const unsigned keys = 5;
+
+  for(size_t threshold: {1, 2, 64})
+    for(int n = 0; n < 100; ++n)
+      {
+        generic_tentative<robed_label> ET(keys);
+        generic_permanent<robed_label> EP(keys);
+        generic_lazy_tentative<robed_label> LT(keys, threshold);
+        generic_permanent<robed_label> LP(keys);
+        unsigned w = 0;
+
+        std::uniform_int_distribution<unsigned> d(0, 6), k(0, keys - 1);
+
+        for(int i = 0; i < 200; ++i)
+          {
+            if (unsigned a = d(gen), b = d(gen); a < b)
+              {
+                robed_label l(label(w + d(gen), {a, b}), k(gen));
+
+                if (!has_better_or_equal(EP, l) &&
+                    !has_better_or_equal(ET, l))
+                  ET.push(l);
+                if (!has_better_or_equal(LP, l))
+                  LT.push(l);
+              }
+
+            if (gen() % 3 == 0)
+              {
+                LT.purge(LP);
+                assert(ET.empty() == LT.empty());
+                if (!ET.empty())
+                  {
+                    const auto &l = EP.push(ET.pop());
+                    assert(LP.push(LT.pop()) == l);
+                    w = get_weight(l);
+                  }
+              }
+          }
+
+        for(LT.purge(LP); !ET.empty(); LT.purge(LP))
+          assert(LP.push(LT.pop()) == EP.push(ET.pop()));
+        assert(LT.empty());
+        assert(LP == EP);
+      }
+}
+
+int
+main()
+{
+  test_purge();
+  test_compact();
+  test_eager();
+}
@@ -0,0 +1,125 @@
+#include "generic_modulation.hpp"
+#include "generic_bounds.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using format = modulation_format<unsigned>;
+
+void
+test_table()
+{
+  // The third format is of no use: the first reaches further, and is
+  // narrower.
+  modulation_table<unsigned> t({{20, 4}, {10, 2}, {15, 5}, {40, 6},
+                                {40, 7}});
+  assert((t.m_formats == std::vector<format>{{10, 2}, {20, 4}, {40, 6}}));
+
+  assert(*t.best(0) == (format{10, 2}));
+  assert(*t.best(10) == (format{10, 2}));
+  assert(*t.best(11) == (format{20, 4}));
+  assert(*t.best(40) == (format{40, 6}));
+  assert(!t.best(41));
+
+  assert(t.fits(5, CU(0, 2)));
+  assert(!t.fits(15, CU(0, 2)));
+  assert(t.fits(15, CU(0, 4)));
+  assert(!t.fits(41, CU(0, 9)));
+
+  auto fs = t.formats(5, CU(0, 4));
+  assert(std::vector(fs.begin(), fs.end()) ==
+         (std::vector<format>{{10, 2}, {20, 4}}));
+  assert(t.formats(15, CU(0, 3)).empty());
+  assert(t.formats(15, CU(0, 9)).size() == 2);
+}
+
+// The functor of a single search for all formats.
+struct modulation_functor
+{
+  generic_modulation_creator<unsigned> m_c;
+
+  std::vector<label>
+  operator()(const label &l, const edge &e) const
+  {
+    auto [w, r] = m_c(l, e);
+
+    if (r.empty())
+      return {};
+
+    return {label({w, r}, e)};
+  }
+};
+
+// The functor of the search for one format of the given width.
+struct width_functor
+{
+  unsigned m_width;
+
+  std::vector<label>
+  operator()(const label &l, const edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty() || r.max() - r.min() < m_width)
+      return {};
+
+    return {label({w, r}, e)};
+  }
+};
+
+// Every label yielded by the search for a format is matched by a
+// label of the single search that is better than or equal to it, and
+// that can use the format.  Every label of the single search can use
+// some format.
+void
+test_search()
+{
+  std::mt19937 gen(1);
+  modulation_table<unsigned> t({{10, 2}, {20, 4}, {40, 6}});
+
+  for(int k = 0; k < 200; ++k)
+    {
+      auto g = random_graph(10, 30, gen);
+      const unsigned src = 0, dst = 9;
+      edge ie(g[src], g[src], 0, CU(0, 9));
+      const label initial({0, CU(0, 9)}, ie);
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      std::vector<label> ls;
+      for(const auto &l: generic_search(P, T, modulation_functor{t},
+                                        initial, dst))
+        {
+          assert(!t.formats(get_weight(l), get_resources(l)).empty());
+          ls.push_back(l);
+        }
+
+      for(const auto &fm: t.m_formats)
+        {
+          bounded_functor f(width_functor{fm.m_width},
+                            search_bounds<unsigned>{fm.m_reach});
+          generic_permanent<label> P2(g.size());
+          generic_tentative<label> T2(g.size());
+          for(const auto &l2: generic_search(P2, T2, f, initial, dst))
+            assert(std::ranges::any_of(ls, [&](const auto &l)
+            {
+              return boe(l, l2) &&
+                std::ranges::count(t.formats(get_weight(l),
+                                             get_resources(l)), fm);
+            }));
+        }
+    }
+}
+
+int
+main()
+{
+  test_table();
+  test_search();
+}
@@ -0,0 +1,79 @@
+#include "generic_pareto.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using robed_label = label_robe<CU>;
+using label = robed_label::label_type;
+
+// A label is rejected if a label is better than or equal to it, and
+// it replaces the labels it is better than or equal to.
+void
+test_insert()
+{
+  generic_pareto<robed_label> P(1);
+
+  assert(P.insert(robed_label(label(3, {0, 2}), 0)));
+  assert(P.insert(robed_label(label(1, {0, 1}), 0)));
+  assert(!P.insert(robed_label(label(4, {0, 1}), 0)));
+  assert(!P.insert(robed_label(label(1, {0, 1}), 0)));
+  assert(P.insert(robed_label(label(2, {2, 4}), 0)));
+  // This one replaces label(3, {0, 2}).
+  assert(P.insert(robed_label(label(2, {0, 3}), 0)));
+
+  assert(P[0].size() == 3);
+  assert(P[0][0] == robed_label(label(1, {0, 1}), 0));
+  assert(P[0][1] == robed_label(label(2, {0, 3}), 0));
+  assert(P[0][2] == robed_label(label(2, {2, 4}), 0));
+
+  assert(P.contains(robed_label(label(2, {2, 4}), 0)));
+  assert(!P.contains(robed_label(label(3, {0, 2}), 0)));
+  assert(has_better_or_equal(P, robed_label(label(3, {1, 2}), 0)));
+}
+
+// The labels inserted in a random order should be the
+// boe-incomparable labels of all labels, sorted with <.
+void
+test_random()
+{
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<unsigned> wd(0, 20), ud(0, 10);
+
+  for(int k = 0; k < 100; ++k)
+    {
+      generic_pareto<robed_label> P(1);
+      std::vector<robed_label> all;
+
+      for(int i = 0; i < 50; ++i)
+        {
+          unsigned a = ud(gen), b = ud(gen);
+          if (a > b)
+            std::swap(a, b);
+          robed_label l(label(wd(gen), {a, b + 1}), 0);
+          all.push_back(l);
+          P.insert(l);
+        }
+
+      std::vector<robed_label> expected;
+      for(const auto &l: all)
+        if (std::ranges::none_of(all, [&](const auto &i)
+        {
+          return boe(i, l) && i != l;
+        }) && std::ranges::find(expected, l) == expected.end())
+          expected.push_back(l);
+      std::ranges::sort(expected);
+
+      assert(P[0] == expected);
+    }
+}
+
+int
+main()
+{
+  test_insert();
+  test_random();
+}
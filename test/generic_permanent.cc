@@ -12,14 +12,18 @@
 
 using namespace std;
 
-template<typename Units>
+// The permanent labels with at most two labels per key inline.
+template <typename Label>
+using small_permanent = generic_small_permanent<Label, 2>;
+
+template<typename Units, template<typename> typename C>
 void
 boe()
 {
   using robed_label = label_robe<Units>;
   using label = robed_label::label_type;
 
-  generic_permanent<robed_label> P(1);
+  C<robed_label> P(1);
 
   // We're inserting labels with non-decreasing cost.
   robed_label rl1(label(1, {2, 4}), 0);
@@ -39,8 +43,42 @@ boe()
   assert(has_better_or_equal(P, rl4));
 }
 
+// A key gets its columns once it has boe_any_min labels, and then
+// has_better_or_equal compares with the kernels as it did without.
+template<template<typename> typename C>
+void
+columns()
+{
+  using robed_label = label_robe<CU>;
+  using label = robed_label::label_type;
+
+  static_assert(C<robed_label>::columnar);
+  C<robed_label> P(2);
+  P.push(robed_label(label(1, {0, 2}), 1));
+
+  for(unsigned i = 0; i < 20; ++i)
+    {
+      P.push(robed_label(label(i, {i, i + 2}), 0));
+      assert(P.m_columns[0].size() ==
+             (P[0].size() < boe_any_min ? 0 : P[0].size()));
+
+      for(unsigned w = 0; w <= i; ++w)
+        {
+          robed_label j(label(w + 1, {w, w + 1}), 0);
+          assert(has_better_or_equal(P, j));
+          assert(!has_better_or_equal(P, robed_label(label(w, {w, w + 3}),
+                                                     0)));
+        }
+    }
+
+  assert(P.m_columns[1].size() == 0);
+}
+
 int
 main()
 {
-  boe<CU>();
+  boe<CU, generic_permanent>();
+  boe<CU, small_permanent>();
+  columns<generic_permanent>();
+  columns<small_permanent>();
 }
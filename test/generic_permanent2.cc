@@ -1,3 +1,4 @@
+#include "generic_packed_label.hpp"
 #include "generic_permanent2.hpp"
 #include "label_robe.hpp"
 #include "units.hpp"
@@ -32,9 +33,63 @@ boe_su()
   assert(has_better_or_equal(P, robed_label(l2, 0)));
 }
 
+// The packed label must be ordered in generic_permanent2 exactly as
+// the generic label.
+void
+cmp_packed()
+{
+  using label = generic_label<unsigned, CU>;
+  using packed_label = generic_packed_label<unsigned, CU>;
+
+  generic_permanent2_cmp<label> cmp;
+  generic_permanent2_cmp<packed_label> packed_cmp;
+
+  std::vector<std::pair<label, packed_label>> ls;
+
+  for(unsigned w = 0; w < 3; ++w)
+    for(unsigned i = 0; i < 5; ++i)
+      for(unsigned j = i + 1; j <= 5; ++j)
+        ls.emplace_back(label(w, {i, j}), packed_label(w, {i, j}));
+
+  for(const auto &[a, pa]: ls)
+    for(const auto &[b, pb]: ls)
+      assert(cmp(a, b) == packed_cmp(pa, pb));
+}
+
+// The extracted labels should leave the columns: the labels that are
+// left compare as they do with boe2.
+void
+extract()
+{
+  using robed_label = label_robe<CU>;
+  using label = robed_label::label_type;
+
+  generic_permanent2<robed_label> P(1);
+  for(unsigned i = 0; i < 20; ++i)
+    P.push(robed_label(label(i, {i, i + 2}), 0));
+
+  for(unsigned k = 0; k < 20; k += 3)
+    {
+      auto i = P[0].find(robed_label(label(k, {k, k + 2}), 0));
+      assert(i != P[0].end());
+      auto nh = P.extract(i);
+      assert(nh.value() == robed_label(label(k, {k, k + 2}), 0));
+
+      for(unsigned w = 0; w < 20; ++w)
+        {
+          robed_label j(label(w + 1, {w, w + 1}), 0);
+          assert(has_better_or_equal(P, j) == boe2(P[0], j));
+        }
+    }
+
+  assert(P[0].size() == 13);
+}
+
 int
 main()
 {
   boe_cu();
   boe_su();
+  cmp_packed();
+  extract();
 }
@@ -0,0 +1,110 @@
+#include "generic_pipeline.hpp"
+#include "generic_bounds.hpp"
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+// The functor of the search with the same checks as the pipeline
+// below.
+struct width_functor
+{
+  unsigned m_width;
+
+  std::vector<label>
+  operator()(const label &l, const edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty() || r.max() - r.min() < m_width)
+      return {};
+
+    return {label({w, r}, e)};
+  }
+};
+
+// The stage that adds a penalty for every edge.
+struct edge_penalty
+{
+  unsigned m_penalty;
+
+  bool
+  operator()(const label &, const edge &, unsigned &w, const CU &) const
+  {
+    w += m_penalty;
+    return true;
+  }
+};
+
+// The pipeline yields the labels of the functor with the same checks,
+// and gives their paths.
+void
+test_search()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 100; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      const unsigned src = 0, dst = 19;
+      edge ie(g[src], g[src], 0, CU(0, 9));
+      const label initial({0, CU(0, 9)}, ie);
+
+      bounded_functor f1(width_functor{3}, search_bounds<unsigned>{20});
+      generic_permanent<label> P1(g.size());
+      generic_tentative<label> T1(g.size());
+      std::vector<label> ls1;
+      for(const auto &l: generic_search(P1, T1, f1, initial, dst))
+        ls1.push_back(l);
+
+      std::size_t before = 0, after = 0;
+      const auto f2 = creator<label> | candidate_counter{&before}
+        | width_filter<3> | weight_cap(20u) | candidate_counter{&after};
+      generic_permanent<label> P2(g.size());
+      generic_tentative<label> T2(g.size());
+      std::vector<label> ls2;
+      for(const auto &l: generic_search(P2, T2, f2, initial, dst))
+        {
+          ls2.push_back(l);
+
+          unsigned w = 0, v = dst;
+          for(const auto &pl: generic_path_range(P2, f2, l, initial))
+            {
+              assert(get_key(get_target(get_edge(pl))) == v);
+              v = get_key(get_source(get_edge(pl)));
+              w += get_weight(get_edge(pl));
+            }
+          assert(v == src);
+          assert(w == get_weight(l));
+        }
+
+      assert(ls1 == ls2);
+      assert(after <= before);
+
+      // The penalties add up along the path.
+      const auto f3 = creator<label> | edge_penalty{100};
+      generic_permanent<label> P3(g.size());
+      generic_tentative<label> T3(g.size());
+      for(const auto &l: generic_search(P3, T3, f3, initial, dst))
+        {
+          unsigned w = 0, hops = 0;
+          for(const auto &pl: generic_path_range(P3, f3, l, initial))
+            {
+              w += get_weight(get_edge(pl));
+              ++hops;
+            }
+          assert(get_weight(l) == w + 100 * hops);
+        }
+    }
+}
+
+int
+main()
+{
+  test_search();
+}
@@ -0,0 +1,178 @@
+#include "generic_permanent.hpp"
+#include "generic_renumbering.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// The neighbours of a graph of adjacency lists.
+using graph = std::vector<std::vector<std::size_t>>;
+
+// A path of count vertexes, whose keys are shuffled.
+graph
+shuffled_path(std::size_t count)
+{
+  std::vector<std::size_t> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::mt19937 gen(1);
+  std::ranges::shuffle(keys, gen);
+
+  graph g(count);
+  for(std::size_t i = 0; i + 1 < count; ++i)
+    {
+      g[keys[i]].push_back(keys[i + 1]);
+      g[keys[i + 1]].push_back(keys[i]);
+    }
+
+  return g;
+}
+
+// The largest difference of the new keys of neighbours.
+std::size_t
+bandwidth(const graph &g, const vertex_renumbering &r)
+{
+  std::size_t b = 0;
+  for(std::size_t v = 0; v < g.size(); ++v)
+    for(auto n: g[v])
+      b = std::max(b, std::max(r.to_new(v), r.to_new(n)) -
+                   std::min(r.to_new(v), r.to_new(n)));
+  return b;
+}
+
+// Function f makes the renumbering, for which the bandwidth of the
+// paths should be at most b.
+template <typename F>
+void
+test_order(F f, std::size_t b)
+{
+  // Two paths: the graph is disconnected.
+  auto g = shuffled_path(100);
+  auto h = shuffled_path(50);
+  auto offset = g.size();
+  for(auto &ns: h)
+    {
+      for(auto &n: ns)
+        n += offset;
+      g.push_back(ns);
+    }
+
+  auto r = f(g.size(), [&](std::size_t v) -> const auto &
+  {
+    return g[v];
+  });
+
+  // The renumbering is a permutation.
+  assert(r.size() == g.size());
+  for(std::size_t i = 0; i < g.size(); ++i)
+    assert(r.to_old(r.to_new(i)) == i);
+
+  assert(bandwidth(g, r) <= b);
+}
+
+// The search on the renumbered graph should find the labels of the
+// search on the original graph, and the paths of the original graph.
+void
+test_search()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(30, 100, gen);
+      auto r = rcm_renumbering(g.size(), [&](std::size_t v)
+      {
+        std::vector<std::size_t> ns;
+        for(const auto &e: get_edges(g[v]))
+          ns.push_back(get_key(get_target(e)));
+        return ns;
+      });
+
+      std::deque<vertex> h;
+      for(unsigned i = 0; i < g.size(); ++i)
+        h.emplace_back(i);
+      renumber_edges(g, r, [&](std::size_t s, std::size_t t, const edge &e)
+      {
+        h[s].m_edges.emplace_back(h[s], h[t], get_weight(e),
+                                  get_resources(e), get_key(e));
+      });
+
+      const unsigned src = 0, dst = 29;
+      const CU units(0, 9);
+      functor f;
+
+      edge gie(g[src], g[src], 0, units);
+      generic_permanent<label> gP(g.size());
+      generic_tentative<label> gT(g.size());
+      std::vector<label> gls;
+      for(const auto &l: generic_search(gP, gT, f, label({0, units}, gie),
+                                        dst))
+        gls.push_back(l);
+
+      edge hie(h[r.to_new(src)], h[r.to_new(src)], 0, units);
+      const label initial({0, units}, hie);
+      generic_permanent<label> hP(h.size());
+      generic_tentative<label> hT(h.size());
+      std::vector<label> hls;
+      for(const auto &l: generic_search(hP, hT, f, initial, r.to_new(dst)))
+        {
+          hls.push_back(l);
+
+          // The path goes through the original graph: the edges of
+          // the path, which have the keys of the original edges, go
+          // between the original keys.
+          auto keys = renumbered_path(r, hP, f, l, initial);
+          assert(keys.front() == src && keys.back() == dst);
+
+          std::vector<const edge *> es;
+          for(const auto &pl: generic_path_range(hP, f, l, initial))
+            es.insert(es.begin(), &get_edge(pl));
+          assert(es.size() + 1 == keys.size());
+
+          unsigned w = 0;
+          for(std::size_t i = 0; i < es.size(); ++i)
+            {
+              auto j = std::ranges::find(get_edges(g[keys[i]]),
+                                         get_key(*es[i]),
+                                         [](const edge &e)
+                                         {
+                                           return get_key(e);
+                                         });
+              assert(j != get_edges(g[keys[i]]).end());
+              assert(get_key(get_target(*j)) == keys[i + 1]);
+              w += get_weight(*j);
+            }
+          assert(w == get_weight(l));
+        }
+
+      // The same labels, which are not equal as labels, because their
+      // edges differ.
+      assert(gls.size() == hls.size());
+      for(std::size_t i = 0; i < gls.size(); ++i)
+        assert(get_weight(gls[i]) == get_weight(hls[i]) &&
+               get_resources(gls[i]) == get_resources(hls[i]));
+
+      // The labels of the original keys.
+      for(std::size_t i = 0; i < g.size(); ++i)
+        assert(gP[i].size() == hP[r.to_new(i)].size());
+    }
+}
+
+int
+main()
+{
+  // The search can start in the middle of a path, and then it numbers
+  // both directions in turns.
+  test_order([](auto count, auto f){return bfs_renumbering(count, f);},
+             2);
+  // The search starts at an end of a path.
+  test_order([](auto count, auto f){return rcm_renumbering(count, f);},
+             1);
+  test_search();
+}
@@ -0,0 +1,426 @@
+#include "generic_path_range.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "test_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// The labels of the search, copied.
+template <typename Range>
+std::vector<label>
+collect(Range &&r)
+{
+  std::vector<label> ls;
+  for(const auto &l: r)
+    ls.push_back(l);
+  return ls;
+}
+
+// The boe-incomparable labels of ls, sorted with <.
+std::vector<label>
+front(std::vector<label> ls)
+{
+  std::ranges::stable_sort(ls);
+  std::vector<label> f;
+  for(const auto &l: ls)
+    if (!boe(f, l))
+      f.push_back(l);
+  return f;
+}
+
+// The baseline generic Dijkstra: the plain loop that takes every
+// label that becomes permanent, and relaxes all its edges, until there
+// are no tentative labels.
+template <typename Permanent, typename Tentative, typename Functor>
+void
+dijkstra(Permanent &P, Tentative &T, const Functor &f, const label &initial)
+{
+  T.push(initial);
+
+  while(!T.empty())
+    {
+      const auto &l = P.push(T.pop());
+
+      for(const auto &e: get_edges(get_target(get_edge(l))))
+        for(auto &c: f(l, e))
+          if (!has_better_or_equal(P, c) && !has_better_or_equal(T, c))
+            T.push(std::move(c));
+    }
+}
+
+// The search should yield the permanent labels of the target that the
+// baseline finds, in the same order, and it should expand no label of
+// the target, i.e., no permanent label leaves the target.
+void
+test_baseline()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 100; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      const unsigned src = 0, dst = 19;
+      edge ie(g[src], g[src], 0, CU(0, 9));
+      label initial({0, CU(0, 9)}, ie);
+      functor f;
+
+      generic_permanent<label> bP(g.size());
+      generic_tentative<label> bT(g.size());
+      dijkstra(bP, bT, f, initial);
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      auto ls = collect(generic_search(P, T, f, initial, dst));
+
+      assert(std::ranges::equal(ls, bP[dst]));
+      assert(std::ranges::equal(P[dst], bP[dst]));
+
+      for(const auto &vd: P)
+        for(const auto &l: vd)
+          assert(get_key(get_source(get_edge(l))) != dst);
+    }
+}
+
+// The search for many targets should yield the boe-incomparable labels
+// of the searches for every target.
+void
+test_targets()
+{
+  std::mt19937 gen(1);
+  const std::vector<unsigned> dsts = {17, 18, 19};
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      edge ie(g[0], g[0], 0, CU(0, 9));
+      label initial({0, CU(0, 9)}, ie);
+      functor f;
+
+      std::vector<label> all;
+      for(auto dst: dsts)
+        {
+          generic_permanent<label> P(g.size());
+          generic_tentative<label> T(g.size());
+          auto ls = collect(generic_search(P, T, f, initial, dst));
+          all.insert(all.end(), ls.begin(), ls.end());
+        }
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      auto ls = collect(generic_multi_search(P, T, f, {initial},
+                                             search_targets(dsts)));
+
+      assert(ls == front(all));
+      for(const auto &l: ls)
+        assert(std::ranges::count(dsts, get_key(l)) == 1);
+    }
+}
+
+// The search from many sources should yield the boe-incomparable
+// labels of the searches from every source, and the paths should
+// start at the sources they are found for.
+void
+test_sources()
+{
+  std::mt19937 gen(1);
+  const std::vector<unsigned> srcs = {0, 1, 2};
+  const unsigned dst = 19;
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      std::vector<edge> ies;
+      ies.reserve(srcs.size());
+      std::vector<label> initials;
+      for(auto src: srcs)
+        {
+          ies.emplace_back(g[src], g[src], 0, CU(0, 9));
+          initials.emplace_back(label::label_type(0, CU(0, 9)), ies.back());
+        }
+      functor f;
+
+      std::vector<label> all;
+      for(const auto &initial: initials)
+        {
+          generic_permanent<label> P(g.size());
+          generic_tentative<label> T(g.size());
+          auto ls = collect(generic_search(P, T, f, initial, dst));
+          all.insert(all.end(), ls.begin(), ls.end());
+        }
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      std::vector<label> ls;
+      for(const auto &l: generic_multi_search(P, T, f, initials,
+                                              search_target<unsigned>{dst}))
+        {
+          ls.push_back(l);
+
+          auto i = generic_path_source(P, f, l, initials);
+          assert(i < srcs.size());
+
+          unsigned w = 0;
+          const edge *first = nullptr;
+          for(const auto &pl: generic_path_range(P, f, l, initials[i]))
+            {
+              w += get_weight(get_edge(pl));
+              first = &get_edge(pl);
+            }
+          assert(w == get_weight(l));
+          assert(first && get_key(get_source(*first)) == srcs[i]);
+        }
+
+      // The labels of the many sources are the boe-incomparable
+      // labels of all sources.
+      auto f1 = front(all), f2 = front(ls);
+      assert(f1 == f2);
+    }
+}
+
+// Counts the calls of the functor.
+struct counting_functor
+{
+  std::size_t *m_calls;
+
+  auto
+  operator()(const label &l, const edge &e) const
+  {
+    ++*m_calls;
+    return functor()(l, e);
+  }
+};
+
+// A probe derived from the null probe that has no yielded.
+struct derived_probe: null_probe
+{
+};
+
+// A probe that has yielded.
+struct path_probe: null_probe
+{
+  std::size_t *m_paths;
+
+  template <typename Path>
+  void
+  yielded(const Path &)
+  {
+    ++*m_paths;
+  }
+};
+
+// The search from many sources should go through the paths only for
+// the probe that has yielded.
+void
+test_probe()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 20; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      edge ie0(g[0], g[0], 0, CU(0, 9)), ie1(g[1], g[1], 0, CU(0, 9));
+      std::vector<label> initials = {label({0, CU(0, 9)}, ie0),
+                                     label({0, CU(0, 9)}, ie1)};
+      const search_target<unsigned> dst{19};
+
+      std::size_t calls[3] = {}, paths = 0, labels = 0;
+
+      {
+        generic_permanent<label> P(g.size());
+        generic_tentative<label> T(g.size());
+        for([[maybe_unused]] const auto &l:
+              generic_multi_search(P, T, counting_functor{&calls[0]},
+                                   initials, dst))
+          ++labels;
+      }
+
+      {
+        generic_permanent<label> P(g.size());
+        generic_tentative<label> T(g.size());
+        for([[maybe_unused]] const auto &l:
+              generic_multi_search(P, T, counting_functor{&calls[1]},
+                                   initials, dst, derived_probe()))
+          ;
+      }
+
+      {
+        generic_permanent<label> P(g.size());
+        generic_tentative<label> T(g.size());
+        for([[maybe_unused]] const auto &l:
+              generic_multi_search(P, T, counting_functor{&calls[2]},
+                                   initials, dst, path_probe{{}, &paths}))
+          ;
+      }
+
+      assert(calls[0] == calls[1]);
+      assert(paths == labels);
+      assert(!labels || calls[0] < calls[2]);
+    }
+}
+
+// Counts what the search does.
+struct counting_probe: null_probe
+{
+  std::size_t *m_pushed;
+  std::size_t *m_checked;
+
+  void
+  pushed()
+  {
+    ++*m_pushed;
+  }
+
+  void
+  dominance_checked()
+  {
+    ++*m_checked;
+  }
+};
+
+// The tentative labels that cannot take a batch.
+struct one_by_one: generic_tentative<label>
+{
+  using generic_tentative<label>::generic_tentative;
+
+  std::size_t
+  push_batch(std::vector<label> &) = delete;
+};
+
+// The search that pushes the candidates in a batch should count the
+// dominance checks as the search that pushes them one by one does,
+// and the labels pushed should be the labels the tentative labels
+// took.
+void
+test_batch_probe()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 50; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      edge ie(g[0], g[0], 0, CU(0, 9));
+      label initial({0, CU(0, 9)}, ie);
+      functor f;
+
+      std::size_t pushed[2] = {}, checked[2] = {};
+
+      generic_permanent<label> P1(g.size());
+      generic_tentative<label> T1(g.size());
+      for([[maybe_unused]] const auto &l:
+            generic_search(P1, T1, f, initial, 19u,
+                           counting_probe{{}, &pushed[0], &checked[0]}))
+        ;
+
+      generic_permanent<label> P2(g.size());
+      one_by_one T2(g.size());
+      for([[maybe_unused]] const auto &l:
+            generic_search(P2, T2, f, initial, 19u,
+                           counting_probe{{}, &pushed[1], &checked[1]}))
+        ;
+
+      assert(P1 == P2);
+      assert(checked[0] == checked[1]);
+      // One by one, a label pushed can be purged by a candidate pushed
+      // after it, which the batch drops before pushing.
+      assert(pushed[0] <= pushed[1]);
+
+      // Every label that became permanent, except the initial one, was
+      // pushed, and so was every label left.
+      std::size_t permanent = 0;
+      for(const auto &vd: P1)
+        permanent += vd.size();
+      assert(pushed[0] >= permanent - 1 + T1.label_count());
+    }
+}
+
+// The path of a label from a source that is not among the initial
+// labels cannot be traced to them.
+void
+test_no_source()
+{
+  std::mt19937 gen(1);
+  std::size_t labels = 0;
+
+  for(int k = 0; k < 20; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      edge ie0(g[0], g[0], 0, CU(0, 9)), ie1(g[1], g[1], 0, CU(0, 9));
+      label i0({0, CU(0, 9)}, ie0), i1({0, CU(0, 9)}, ie1);
+      functor f;
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      for(const auto &l: generic_search(P, T, f, i0, 19u))
+        {
+          ++labels;
+          assert(generic_path_source(P, f, l, std::vector{i0}) == 0);
+
+          bool thrown = false;
+          try
+            {
+              generic_path_source(P, f, l, std::vector{i1});
+            }
+          catch (const std::invalid_argument &)
+            {
+              thrown = true;
+            }
+          assert(thrown);
+        }
+    }
+
+  assert(labels);
+}
+
+// The initial labels of a source can share the loop edge, and then
+// the path of a label should be traced to the initial label whose
+// resources it has.
+void
+test_shared_loop()
+{
+  std::mt19937 gen(1);
+  std::size_t found[2] = {};
+
+  for(int k = 0; k < 20; ++k)
+    {
+      auto g = random_graph(20, 60, gen);
+      edge ie(g[0], g[0], 0, CU(0, 9));
+      std::vector<label> initials = {label({0, CU(0, 4)}, ie),
+                                     label({0, CU(5, 9)}, ie)};
+      functor f;
+
+      generic_permanent<label> P(g.size());
+      generic_tentative<label> T(g.size());
+      for(const auto &l: generic_multi_search(P, T, f, initials,
+                                              search_target<unsigned>{19}))
+        {
+          auto i = generic_path_source(P, f, l, initials);
+          assert(i < initials.size());
+          ++found[i];
+          assert(includes(get_resources(initials[i]), get_resources(l)));
+
+          unsigned w = 0;
+          for(const auto &pl: generic_path_range(P, f, l, initials[i]))
+            w += get_weight(get_edge(pl));
+          assert(w == get_weight(l));
+        }
+    }
+
+  assert(found[0] && found[1]);
+}
+
+int
+main()
+{
+  test_baseline();
+  test_targets();
+  test_sources();
+  test_probe();
+  test_batch_probe();
+  test_no_source();
+  test_shared_loop();
+}
@@ -0,0 +1,186 @@
+#include "generic_permanent.hpp"
+#include "generic_snapshot.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+using robed_label = label_robe<CU>;
+using label = robed_label::label_type;
+
+// The record of a label: the label with its key is trivially copyable.
+struct record
+{
+  unsigned m_w;
+  unsigned m_min;
+  unsigned m_max;
+  unsigned m_key;
+};
+
+record
+encode(const robed_label &l)
+{
+  return {get_weight(l), get_resources(l).min(), get_resources(l).max(),
+          get_key(l)};
+}
+
+robed_label
+decode(const record &r)
+{
+  return robed_label(label(r.m_w, {r.m_min, r.m_max}), r.m_key);
+}
+
+generic_permanent<robed_label>
+make_permanent()
+{
+  generic_permanent<robed_label> P(3);
+  P.push(robed_label(label(1, {0, 2}), 0));
+  P.push(robed_label(label(2, {1, 3}), 0));
+  P.push(robed_label(label(3, {0, 4}), 2));
+
+  return P;
+}
+
+// The view should have the labels of the permanent, and loading
+// should produce the permanent.
+void
+test_round_trip()
+{
+  auto P = make_permanent();
+  auto fp = snapshot_fingerprint().add(3u).value();
+
+  std::ostringstream out;
+  save_snapshot(out, P, encode, fp);
+
+  // We copy the string into memory aligned as a mapped file.
+  auto s = out.str();
+  std::vector<std::uint64_t> m((s.size() + 7) / 8);
+  std::memcpy(m.data(), s.data(), s.size());
+  std::span<const std::byte> bytes(reinterpret_cast<const std::byte *>
+                                   (m.data()), s.size());
+
+  generic_snapshot_view<record> v(bytes, fp);
+  assert(v.size() == 3);
+  assert(v[0].size() == 2);
+  assert(v[1].empty());
+  assert(v[2].size() == 1);
+  assert(decode(v[2][0]) == P[2][0]);
+
+  generic_permanent<robed_label> Q(3);
+  load_snapshot(Q, v, decode);
+  assert(Q == P);
+
+  // A snapshot of some other state is rejected.
+  bool thrown = false;
+  try
+    {
+      generic_snapshot_view<record> v(bytes, fp + 1);
+    }
+  catch (const std::runtime_error &)
+    {
+      thrown = true;
+    }
+  assert(thrown);
+
+  // A truncated snapshot is rejected.
+  thrown = false;
+  try
+    {
+      generic_snapshot_view<record> v(bytes.first(bytes.size() - 1), fp);
+    }
+  catch (const std::runtime_error &)
+    {
+      thrown = true;
+    }
+  assert(thrown);
+
+  // The numbers of keys and records whose sizes overflow to the size
+  // of the snapshot are rejected.
+  for(auto [keys, records]: {std::pair{3 + (std::uint64_t(1) << 61), 3ul},
+                             std::pair{3ul, 3 + (std::uint64_t(1) << 60)}})
+    {
+      auto c = m;
+      snapshot_header h;
+      std::memcpy(&h, c.data(), sizeof(h));
+      h.m_keys = keys;
+      h.m_records = records;
+      std::memcpy(c.data(), &h, sizeof(h));
+
+      thrown = false;
+      try
+        {
+          generic_snapshot_view<record>
+            v({reinterpret_cast<const std::byte *>(c.data()), s.size()},
+              fp);
+        }
+      catch (const std::runtime_error &)
+        {
+          thrown = true;
+        }
+      assert(thrown);
+    }
+}
+
+// The snapshot should be usable in place from a mapped file.
+void
+test_mapping()
+{
+  auto P = make_permanent();
+  const std::string path = "generic_snapshot.bin";
+
+  {
+    std::ofstream out(path, std::ios::binary);
+    save_snapshot(out, P, encode, 1);
+  }
+
+  {
+    snapshot_mapping m(path);
+    generic_snapshot_view<record> v(m.bytes(), 1);
+    assert(v[0].size() == 2);
+    assert(decode(v[0][1]) == P[0][1]);
+  }
+
+  std::remove(path.c_str());
+}
+
+// The loaded labels should be compared as the pushed ones, also when
+// a key has enough labels for the kernels.
+void
+test_load()
+{
+  generic_permanent<robed_label> P(1);
+  for(unsigned i = 0; i < 20; ++i)
+    P.push(robed_label(label(i, {i, i + 2}), 0));
+
+  std::ostringstream out;
+  save_snapshot(out, P, encode, 1);
+  auto s = out.str();
+  std::vector<std::uint64_t> m((s.size() + 7) / 8);
+  std::memcpy(m.data(), s.data(), s.size());
+  generic_snapshot_view<record> v({reinterpret_cast<const std::byte *>
+                                   (m.data()), s.size()}, 1);
+
+  generic_permanent<robed_label> Q(1);
+  load_snapshot(Q, v, decode);
+  assert(Q == P);
+
+  for(unsigned i = 0; i < 20; ++i)
+    {
+      robed_label j1(label(i + 1, {i, i + 1}), 0);
+      robed_label j2(label(i, {i, i + 3}), 0);
+      assert(has_better_or_equal(Q, j1));
+      assert(!has_better_or_equal(Q, j2));
+    }
+}
+
+int
+main()
+{
+  test_round_trip();
+  test_mapping();
+  test_load();
+}
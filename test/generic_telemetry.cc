@@ -0,0 +1,123 @@
+#include "generic_telemetry.hpp"
+
+#include <cassert>
+#include <sstream>
+#include <thread>
+
+// A record whose fields are all n, so that we can tell a torn record.
+search_record
+make_record(std::uint64_t n)
+{
+  return {n, n, n, n, n, n, n};
+}
+
+bool
+consistent(const search_record &r)
+{
+  for(std::size_t i = 1; i < search_record_size; ++i)
+    if (get_field(r, i) != r.m_time_ns)
+      return false;
+  return true;
+}
+
+// The ring keeps the latest records, and a reader running along with
+// the writer gets whole records only.
+void
+test_ring()
+{
+  telemetry_ring ring;
+  const std::uint64_t n = 10 * telemetry_ring::capacity;
+
+  std::jthread writer([&]
+  {
+    for(std::uint64_t i = 0; i < n; ++i)
+      ring.write(make_record(i));
+  });
+
+  for(int k = 0; k < 100; ++k)
+    {
+      std::vector<search_record> rs;
+      ring.read(rs);
+      for(const auto &r: rs)
+        assert(consistent(r));
+    }
+
+  writer.join();
+
+  std::vector<search_record> rs;
+  ring.read(rs);
+  assert(rs.size() == telemetry_ring::capacity);
+  assert(rs.front().m_time_ns == n - telemetry_ring::capacity);
+  assert(rs.back().m_time_ns == n - 1);
+}
+
+// The probe writes to the ring of its thread, and the registry
+// collects the rings of all threads.
+void
+test_probe()
+{
+  auto before = telemetry_registry::get().collect().size();
+
+  std::jthread([]
+  {
+    telemetry_probe p;
+    p.start();
+    p.popped(3);
+    p.popped(5);
+    p.popped(4);
+    p.pushed();
+    p.dominance_checked();
+    p.dominance_checked();
+    p.finish();
+  }).join();
+
+  auto rs = telemetry_registry::get().collect();
+  assert(rs.size() == before + 1);
+  const auto &r = rs.back();
+  assert(r.m_popped == 3);
+  assert(r.m_peak_tentative == 5);
+  assert(r.m_pushed == 1);
+  assert(r.m_dominance_checks == 2);
+  assert(r.m_labels == 0);
+}
+
+void
+test_dumps()
+{
+  std::vector<search_record> rs = {make_record(0), make_record(1),
+                                   make_record(5)};
+
+  std::ostringstream csv;
+  write_csv(csv, rs);
+  assert(csv.str().starts_with("time_ns,popped,"));
+  assert(csv.str().ends_with("\n5,5,5,5,5,5,5\n"));
+
+  std::ostringstream json;
+  write_json(json, {make_record(2)});
+  assert(json.str() == "[{\"time_ns\": 2, \"popped\": 2, \"pushed\": 2, "
+         "\"peak_tentative\": 2, \"dominance_checks\": 2, \"labels\": 2, "
+         "\"hops\": 2}]\n");
+
+  // The bins: 0, [1, 2), [2, 4), [4, 8).
+  auto h = histogram(rs, 1);
+  assert((h == std::vector<std::size_t>{1, 1, 0, 1}));
+
+  std::ostringstream hs;
+  write_histogram(hs, h);
+  assert(hs.str() == "[0, 1): 1\n[1, 2): 1\n[2, 4): 0\n[4, 8): 1\n");
+
+  // The largest values go to bin 64, which has no max.
+  h = histogram({make_record(UINT64_MAX)}, 1);
+  assert(h.size() == 65 && h[64] == 1);
+  std::ostringstream ls;
+  write_histogram(ls, h);
+  assert(ls.str().ends_with("[9223372036854775808, inf): 1\n"));
+}
+
+int
+main()
+{
+  test_ring();
+  test_probe();
+  test_dumps();
+}
@@ -0,0 +1,144 @@
+#include "generic_permanent2.hpp"
+#include "generic_tentative.hpp"
+#include "label_robe.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+using robed_label = label_robe<CU>;
+using label = robed_label::label_type;
+
+// The labels should be popped in the order of <, and the worse or
+// equal labels should be purged.
+void
+test_pop()
+{
+  generic_tentative<robed_label> T(2);
+
+  T.push(robed_label(label(3, {0, 2}), 0));
+  T.push(robed_label(label(1, {0, 1}), 1));
+  T.push(robed_label(label(2, {2, 4}), 0));
+  assert(T.label_count() == 3);
+  // This one purges label(3, {0, 2}).
+  T.push(robed_label(label(2, {0, 3}), 0));
+  assert(T.label_count() == 3);
+
+  assert(T.pop() == robed_label(label(1, {0, 1}), 1));
+  assert(T.pop() == robed_label(label(2, {0, 3}), 0));
+  assert(T.pop() == robed_label(label(2, {2, 4}), 0));
+  assert(T.empty());
+  assert(T.label_count() == 0);
+  assert(T.peak_label_count() == 3);
+}
+
+// The node of a popped label should be pushed into the permanent
+// labels as is.
+void
+test_node()
+{
+  static_assert(std::is_same_v<generic_tentative<robed_label>::node_type,
+                generic_permanent2<robed_label>::node_type>);
+
+  generic_tentative<robed_label> T(1);
+  generic_permanent2<robed_label> P(1);
+
+  T.push(robed_label(label(1, {0, 2}), 0));
+  T.push(robed_label(label(2, {0, 3}), 0));
+
+  auto nh = T.pop_node();
+  const auto *ptr = &nh.value();
+  const auto &l = P.push(std::move(nh));
+  // The label was not moved, so it is where it was in T.
+  assert(&l == ptr);
+  assert(l == robed_label(label(1, {0, 2}), 0));
+  assert(has_better_or_equal(P, robed_label(label(1, {0, 1}), 0)));
+
+  // And back from the permanent to the tentative labels.  The label
+  // leaves the columns of P too.
+  T.push(P.extract(P[0].begin()));
+  assert(P[0].empty());
+  assert(!has_better_or_equal(P, robed_label(label(1, {0, 1}), 0)));
+  assert(T.pop() == robed_label(label(1, {0, 2}), 0));
+  assert(T.pop() == robed_label(label(2, {0, 3}), 0));
+  assert(T.empty());
+}
+
+// The labels built in place should be the same as the pushed ones.
+void
+test_emplace()
+{
+  generic_tentative<robed_label> T(1);
+  generic_permanent2<robed_label> P(1);
+
+  T.emplace(label(make_pair(2u, CU(0, 3))), 0);
+  T.emplace(label(1, {0, 2}), 0);
+  assert(T.pop() == robed_label(label(1, {0, 2}), 0));
+
+  P.emplace(label(make_pair(1u, CU(0, 2))), 0);
+  assert(has_better_or_equal(P, robed_label(label(1, {0, 2}), 0)));
+  assert(!has_better_or_equal(P, robed_label(label(1, {0, 3}), 0)));
+}
+
+// The labels pushed in batches should be the labels pushed one by one
+// with the check of has_better_or_equal.
+void
+test_push_batch()
+{
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<unsigned> kd(0, 3), wd(0, 10), ud(0, 8);
+
+  generic_tentative<robed_label> T1(4), T2(4);
+  std::vector<robed_label> batch;
+
+  for(int n = 0; n < 200; ++n)
+    {
+      for(int i = 0; i < 10; ++i)
+        {
+          unsigned a = ud(gen), b = ud(gen);
+          if (a == b)
+            continue;
+          robed_label l(label(wd(gen), {std::min(a, b), std::max(a, b)}),
+                        kd(gen));
+
+          if (!has_better_or_equal(T1, l))
+            T1.push(l);
+          batch.push_back(l);
+        }
+
+      // The labels before the batch.
+      generic_tentative<robed_label>::base_type before = T2;
+      auto pushed = T2.push_batch(batch);
+      assert(batch.empty());
+
+      // The pushed labels are the labels that were not there.
+      size_t added = 0;
+      for(size_t key = 0; key < T2.size(); ++key)
+        for(const auto &l: T2[key])
+          added += !before[key].contains(l);
+      assert(pushed == added);
+
+      assert(T1 == T2);
+      assert(T1.m_pq == T2.m_pq);
+      assert(T1.label_count() == T2.label_count());
+      assert(T2.peak_label_count() >= T2.label_count());
+
+      // Once in a while, a label becomes permanent.
+      if (n % 3 == 0 && !T1.empty())
+        assert(T1.pop() == T2.pop());
+    }
+}
+
+int
+main()
+{
+  test_pop();
+  test_node();
+  test_emplace();
+  test_push_batch();
+}
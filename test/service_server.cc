@@ -0,0 +1,185 @@
+#include "service/service_server.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include <sys/socket.h>
+
+// The graph: 0 -> 1 -> 2 of weights 1, and 0 -> 2 of weight 3.
+const char *graph_text =
+  "3 3 8\n"
+  "0 1 1 0 8\n"
+  "1 2 1 2 6\n"
+  "0 2 3 0 8\n";
+
+// Sends the messages, closes the sending side, and returns the
+// replies by id.
+std::map<std::uint32_t, service_answer>
+exchange(int fd, const std::vector<service_message> &ms)
+{
+  for(const auto &m: ms)
+    {
+      [[maybe_unused]] bool ok = write_full(fd, &m, sizeof(m));
+      assert(ok);
+    }
+  ::shutdown(fd, SHUT_WR);
+
+  std::map<std::uint32_t, service_answer> as;
+  service_answer a;
+  for(std::size_t i = 0; i < ms.size(); ++i)
+    {
+      [[maybe_unused]] bool ok = read_answer(fd, a);
+      assert(ok);
+      as[a.m_header.m_id] = a;
+    }
+
+  return as;
+}
+
+// A socket pair: the first socket for the server, the second for the
+// client.
+std::pair<int, int>
+socket_pair()
+{
+  int fds[2];
+  [[maybe_unused]] int r = ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+  assert(!r);
+  return {fds[0], fds[1]};
+}
+
+// The queries should find the paths, and an update should be applied
+// after the queries sent before it, and before the queries sent after
+// it.
+void
+test_server()
+{
+  for(unsigned workers: {1, 4})
+    {
+      std::istringstream in(graph_text);
+      service_graph g(in);
+      service_server s(g, workers, 8, std::chrono::microseconds(100));
+
+      auto [sfd, cfd] = socket_pair();
+      std::jthread t([&, sfd]{s.serve(sfd);});
+
+      auto as = exchange(cfd, {
+          // Both paths for the width of 2, the shorter path first.
+          {service_query, 0, 0, 2, 2, 0},
+          // Only the first path.
+          {service_query, 1, 0, 2, 2, 1},
+          // Only the direct edge for the width of 5.
+          {service_query, 2, 0, 2, 5, 0},
+          // Edge 1 gets narrow, and so the path through vertex 1
+          // cannot take the width of 2.
+          {service_update, 3, 1, 2, 3, 0},
+          {service_query, 4, 0, 2, 2, 0},
+          // The wrong vertex and the wrong type.
+          {service_query, 5, 0, 3, 2, 0},
+          {7, 6, 0, 0, 0, 0}});
+      ::close(cfd);
+
+      assert(as.size() == 7);
+
+      const auto &a0 = as[0];
+      assert(a0.m_header.m_c == service_ok);
+      assert(a0.m_header.m_a == 2);
+      assert((a0.m_words == std::vector<std::uint32_t>
+              {2, 2, 6, 2, 0, 1, 3, 0, 8, 1, 2}));
+
+      assert(as[1].m_header.m_a == 1);
+      assert(as[1].m_words.size() == 6);
+
+      assert(as[2].m_header.m_a == 1);
+      assert((as[2].m_words == std::vector<std::uint32_t>{3, 0, 8, 1, 2}));
+
+      assert(as[3].m_header.m_c == service_ok);
+      assert(as[3].m_header.m_a == 0);
+
+      assert(as[4].m_header.m_a == 1);
+      assert((as[4].m_words == std::vector<std::uint32_t>{3, 0, 8, 1, 2}));
+
+      assert(as[5].m_header.m_c == service_bad_request);
+      assert(as[6].m_header.m_c == service_bad_request);
+
+      assert(s.m_queries == 4);
+      assert(s.m_updates == 1);
+    }
+}
+
+// A client that does not read its replies is disconnected when its
+// outgoing buffer is full, and the other clients are answered.
+void
+test_slow_client()
+{
+  std::istringstream in(graph_text);
+  service_graph g(in);
+  // At most 64 words of replies wait for a connection.
+  service_server s(g, 2, 8, std::chrono::microseconds(100), 16, 64);
+
+  auto [sfd, cfd] = socket_pair();
+  // The socket takes a few replies only.
+  int size = 4096;
+  ::setsockopt(sfd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  s.connect(sfd);
+
+  // We send until the server disconnects us, and we do not read.
+  const std::size_t n = 100000;
+  std::size_t sent = 0;
+  for(service_message m{service_query, 0, 0, 2, 2, 0}; sent < n; ++sent)
+    if (!write_full(cfd, &m, sizeof(m)))
+      break;
+
+  // We get a part of the replies only.
+  std::size_t replies = 0;
+  for(service_answer a; read_answer(cfd, a); ++replies);
+  assert(replies < sent);
+  ::close(cfd);
+
+  // The other clients are served.
+  auto [sfd2, cfd2] = socket_pair();
+  s.connect(sfd2);
+  auto as = exchange(cfd2, {{service_query, 0, 0, 2, 5, 0}});
+  assert((as[0].m_words == std::vector<std::uint32_t>{3, 0, 8, 1, 2}));
+  ::close(cfd2);
+}
+
+// The server closes the connections it serves when it stops, even if
+// their clients keep them open.
+void
+test_stop()
+{
+  auto [sfd, cfd] = socket_pair();
+
+  {
+    std::istringstream in(graph_text);
+    service_graph g(in);
+    service_server s(g, 1, 8, std::chrono::microseconds(100));
+    s.connect(sfd);
+
+    service_message m{service_query, 0, 0, 2, 5, 0};
+    [[maybe_unused]] bool ok = write_full(cfd, &m, sizeof(m));
+    assert(ok);
+    service_answer a;
+    ok = read_answer(cfd, a);
+    assert(ok);
+    assert(a.m_header.m_a == 1);
+  }
+
+  // The connection is closed.
+  service_answer a;
+  [[maybe_unused]] bool ok = read_answer(cfd, a);
+  assert(!ok);
+  ::close(cfd);
+}
+
+int
+main()
+{
+  test_server();
+  test_slow_client();
+  test_stop();
+}
@@ -0,0 +1,143 @@
+#include "small_vector.hpp"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+// The elements should stay inline up to the capacity, and then spill
+// to the heap.
+void
+test_spill()
+{
+  small_vector<string, 2> v;
+  assert(v.empty() && v.is_inline());
+
+  v.push_back("a");
+  v.push_back("b");
+  assert(v.size() == 2 && v.is_inline());
+
+  // The pushed element refers to an element that moves.
+  v.push_back(v[0]);
+  assert(v.size() == 3 && !v.is_inline());
+  assert(v[0] == "a" && v[1] == "b" && v.back() == "a");
+}
+
+// The copies and the moves should keep the elements.
+void
+test_copy_move()
+{
+  for(int n: {1, 3})
+    {
+      small_vector<string, 2> v;
+      for(int i = 0; i < n; ++i)
+        v.push_back(to_string(i));
+
+      auto c = v;
+      assert(c.size() == v.size());
+      assert(c.back() == v.back());
+
+      auto m = std::move(v);
+      assert(m.size() == c.size());
+      assert(m.back() == c.back());
+      assert(v.empty() && v.is_inline());
+
+      v = m;
+      assert(v.size() == m.size());
+      m = std::move(c);
+      assert(m.size() == v.size());
+      assert(c.empty());
+    }
+}
+
+// The element that counts the live elements, and whose construction
+// throws on demand.
+struct thrower
+{
+  static inline int s_live = 0;
+  // The number of the copies left before a copy throws, or -1.
+  static inline int s_copies = -1;
+
+  int m_v;
+
+  thrower(int v, bool t = false): m_v(v)
+  {
+    if (t)
+      throw std::runtime_error("thrower");
+    ++s_live;
+  }
+
+  thrower(const thrower &t): m_v(t.m_v)
+  {
+    if (s_copies >= 0 && !s_copies--)
+      throw std::runtime_error("thrower");
+    ++s_live;
+  }
+
+  // The move can throw, and so the vector copies.
+  thrower(thrower &&t) noexcept(false): m_v(t.m_v)
+  {
+    ++s_live;
+  }
+
+  ~thrower()
+  {
+    --s_live;
+  }
+};
+
+// When the new element or the relocation throws, the vector should
+// keep its elements, and no element should be left behind.
+void
+test_throw()
+{
+  for(int copies: {0, 1, 2})
+    {
+      small_vector<thrower, 2> v;
+      v.emplace_back(0);
+      v.emplace_back(1);
+
+      // The new element throws.
+      bool thrown = false;
+      try
+        {
+          v.emplace_back(2, true);
+        }
+      catch (const std::runtime_error &)
+        {
+          thrown = true;
+        }
+      assert(thrown);
+      assert(v.size() == 2 && v.is_inline());
+      assert(thrower::s_live == 2);
+
+      // A copy of an old element throws.
+      thrower::s_copies = copies;
+      thrown = false;
+      try
+        {
+          v.emplace_back(2);
+        }
+      catch (const std::runtime_error &)
+        {
+          thrown = true;
+        }
+      thrower::s_copies = -1;
+      assert(thrown == (copies < 2));
+      assert(v.size() == (thrown ? 2 : 3));
+      assert(v[0].m_v == 0 && v[1].m_v == 1);
+      assert(thrower::s_live == int(v.size()));
+    }
+
+  assert(thrower::s_live == 0);
+}
+
+int
+main()
+{
+  test_spill();
+  test_copy_move();
+  test_throw();
+}
@@ -0,0 +1,141 @@
+#ifndef TEST_GRAPH_HPP
+#define TEST_GRAPH_HPP
+
+#include "generic_label.hpp"
+#include "generic_label_creator.hpp"
+#include "props.hpp"
+#include "units.hpp"
+
+#include <deque>
+#include <random>
+#include <vector>
+
+// The graph, the labels, and the functor of the tests that search.
+
+struct vertex;
+
+struct edge: weight<unsigned>, resources<CU>, key<unsigned>
+{
+  const vertex *m_source;
+  const vertex *m_target;
+
+  // The key is the number of the edge in the graph.  The initial loop
+  // edges have none.
+  edge(const vertex &s, const vertex &t, unsigned w, const CU &r,
+       unsigned k = ~0U):
+    weight<unsigned>(w), resources<CU>(r), key<unsigned>(k),
+    m_source(&s), m_target(&t)
+  {
+  }
+
+  bool
+  operator == (const edge &e) const
+  {
+    return this == &e;
+  }
+};
+
+struct vertex: key<unsigned>
+{
+  std::vector<edge> m_edges;
+
+  vertex(unsigned k): key<unsigned>(k)
+  {
+  }
+
+  bool
+  operator == (const vertex &v) const
+  {
+    return this == &v;
+  }
+};
+
+inline const vertex &
+get_source(const edge &e)
+{
+  return *e.m_source;
+}
+
+inline const vertex &
+get_target(const edge &e)
+{
+  return *e.m_target;
+}
+
+inline const auto &
+get_edges(const vertex &v)
+{
+  return v.m_edges;
+}
+
+// The key of the label is the key of the target of its edge.
+struct label: generic_label<unsigned, CU>, key<unsigned>
+{
+  using label_type = generic_label<unsigned, CU>;
+
+  const edge *m_edge;
+
+  label(const label_type &l, const edge &e):
+    label_type(l), key<unsigned>(get_key(get_target(e))), m_edge(&e)
+  {
+  }
+
+  bool operator == (const label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l);
+  }
+
+  auto operator <=> (const label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+inline const edge &
+get_edge(const label &l)
+{
+  return *l.m_edge;
+}
+
+// Produces none or one candidate label.
+struct functor
+{
+  std::vector<label>
+  operator()(const label &l, const edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty())
+      return {};
+
+    return {label({w, r}, e)};
+  }
+};
+
+// A random graph of the given numbers of vertexes and edges.  The
+// vertexes are in a deque, so that they do not move.
+inline std::deque<vertex>
+random_graph(unsigned count, unsigned edges, std::mt19937 &gen)
+{
+  std::deque<vertex> g;
+  for(unsigned i = 0; i < count; ++i)
+    g.emplace_back(i);
+
+  std::uniform_int_distribution<unsigned> vd(0, count - 1), wd(1, 10);
+  std::uniform_int_distribution<unsigned> ud(0, 8);
+
+  for(unsigned k = 0; k < edges; ++k)
+    {
+      unsigned s = vd(gen), t = vd(gen);
+      unsigned a = ud(gen), b = ud(gen);
+      if (a > b)
+        std::swap(a, b);
+      g[s].m_edges.emplace_back(g[s], g[t], wd(gen), CU(a, b + 1), k);
+    }
+
+  return g;
+}
+
+#endif // TEST_GRAPH_HPP
@@ -4,12 +4,19 @@
 #include "label_robe.hpp"
 #include "units.hpp"
 
+#include <algorithm>
+
 // We produce 720 permutations of the same 6 labels defined below.
 // These six labels are incomparable, so has_better_or_equal should
 // always return false, and insertion should always be successfull.
 // The order in which we push labels should not be important, and
 // that's what we test with permutations.
 
+// The permanent labels with at most two labels per key inline, so
+// that the labels spill to the heap.
+template <typename Label>
+using small_permanent = generic_small_permanent<Label, 2>;
+
 template <template<typename...> typename C>
 void
 test_perm()
@@ -43,7 +50,7 @@ test_perm()
         {
           // A candidate label.
           robed_label cl(l, 0);
-          auto i = find(P[0].begin(), P[0].end(), cl);
+          auto i = std::find(P[0].begin(), P[0].end(), cl);
           assert(i != P[0].end());
         }
     } while(std::next_permutation(ls.begin(), ls.end()));
@@ -53,6 +60,7 @@ int
 main()
 {
   test_perm<generic_permanent>();
+  test_perm<small_permanent>();
   test_perm<generic_permanent2>();
   test_perm<generic_tentative>();
 }
@@ -0,0 +1,244 @@
+#include "weight_vector.hpp"
+
+#include "generic_bounds.hpp"
+#include "generic_boe_batch.hpp"
+#include "generic_label.hpp"
+#include "generic_label_creator.hpp"
+#include "generic_permanent.hpp"
+#include "generic_search.hpp"
+#include "generic_tentative.hpp"
+#include "props.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <vector>
+
+// The weight of two criteria: the length and the impairment.
+using weight2 = weight_vector<unsigned, 2>;
+
+struct mc_vertex;
+
+struct mc_edge: weight<weight2>, resources<CU>
+{
+  const mc_vertex *m_source;
+  const mc_vertex *m_target;
+
+  mc_edge(const mc_vertex &s, const mc_vertex &t, weight2 w, const CU &r):
+    weight<weight2>(w), resources<CU>(r), m_source(&s), m_target(&t)
+  {
+  }
+};
+
+struct mc_vertex: key<unsigned>
+{
+  std::vector<mc_edge> m_edges;
+
+  mc_vertex(unsigned k): key<unsigned>(k)
+  {
+  }
+};
+
+inline const mc_vertex &
+get_target(const mc_edge &e)
+{
+  return *e.m_target;
+}
+
+inline const auto &
+get_edges(const mc_vertex &v)
+{
+  return v.m_edges;
+}
+
+struct mc_label: generic_label<weight2, CU>, key<unsigned>
+{
+  using label_type = generic_label<weight2, CU>;
+
+  const mc_edge *m_edge;
+
+  mc_label(const label_type &l, const mc_edge &e):
+    label_type(l), key<unsigned>(get_key(get_target(e))), m_edge(&e)
+  {
+  }
+
+  bool operator == (const mc_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      == static_cast<const label_type &>(l);
+  }
+
+  auto operator <=> (const mc_label &l) const
+  {
+    return static_cast<const label_type &>(*this)
+      <=> static_cast<const label_type &>(l);
+  }
+};
+
+inline const mc_edge &
+get_edge(const mc_label &l)
+{
+  return *l.m_edge;
+}
+
+struct mc_functor
+{
+  std::vector<mc_label>
+  operator()(const mc_label &l, const mc_edge &e) const
+  {
+    auto [w, r] = generic_label_creator()(l, e);
+
+    if (r.empty())
+      return {};
+
+    return {mc_label({w, r}, e)};
+  }
+};
+
+static_assert(!cu_batchable<mc_label>);
+
+void
+test_weight_vector()
+{
+  weight_vector a{1u, 5u}, b{2u, 3u}, c{2u, 4u};
+
+  // Lexicographic.
+  assert(a < b && b < c && a < c);
+  assert((weight_vector{1u, 2u, 3u} < weight_vector{1u, 2u, 4u}));
+  assert((weight_vector{1u, 2u, 3u, 4u} > weight_vector{1u, 2u, 3u, 3u}));
+
+  // Pareto.
+  assert(!weight_boe(a, b) && !weight_boe(b, a));
+  assert(weight_boe(b, c) && !weight_boe(c, b));
+  assert(weight_boe(a, a));
+  assert((weight_boe(weight_vector{1u, 2u, 3u}, weight_vector{1u, 2u, 3u})));
+  assert((!weight_boe(weight_vector{1u, 2u, 4u}, weight_vector{1u, 2u, 3u})));
+  assert((weight_boe(weight_vector{1u, 1u, 1u, 1u},
+                     weight_vector{1u, 2u, 3u, 4u})));
+  assert((!weight_boe(weight_vector{1u, 1u, 1u, 5u},
+                      weight_vector{1u, 2u, 3u, 4u})));
+
+  assert(a + b == (weight_vector{3u, 8u}));
+
+  // Scalar weights are compared as before.
+  assert(weight_boe(1u, 2u) && !weight_boe(2u, 1u));
+
+  using L = generic_label<weight2, CU>;
+  assert(boe(L(b, CU(0, 4)), L(c, CU(1, 3))));
+  assert(!boe(L(a, CU(0, 4)), L(b, CU(1, 3))));
+  assert(!boe(L(b, CU(1, 3)), L(c, CU(0, 4))));
+}
+
+std::deque<mc_vertex>
+random_graph(unsigned count, unsigned edges, std::mt19937 &gen)
+{
+  std::deque<mc_vertex> g;
+  for(unsigned i = 0; i < count; ++i)
+    g.emplace_back(i);
+
+  std::uniform_int_distribution<unsigned> vd(0, count - 1), wd(1, 10);
+  std::uniform_int_distribution<unsigned> ud(0, 8);
+
+  for(unsigned k = 0; k < edges; ++k)
+    {
+      unsigned s = vd(gen), t = vd(gen);
+      unsigned a = ud(gen), b = ud(gen);
+      if (a > b)
+        std::swap(a, b);
+      g[s].m_edges.emplace_back(g[s], g[t], weight2{wd(gen), wd(gen)},
+                                CU(a, b + 1));
+    }
+
+  return g;
+}
+
+// The labels of all simple paths from vertex v to vertex dst.
+void
+all_paths(const std::deque<mc_vertex> &g, unsigned v, unsigned dst,
+          std::vector<bool> &seen, const generic_label<weight2, CU> &l,
+          std::vector<generic_label<weight2, CU>> &ls)
+{
+  if (v == dst)
+    {
+      ls.push_back(l);
+      return;
+    }
+
+  seen[v] = true;
+  for(const auto &e: g[v].m_edges)
+    if (!seen[get_key(get_target(e))])
+      if (auto [w, r] = generic_label_creator()(l, e); !r.empty())
+        all_paths(g, get_key(get_target(e)), dst, seen, {w, r}, ls);
+  seen[v] = false;
+}
+
+// The boe-incomparable labels of ls, sorted with <.
+template <typename Label>
+std::vector<generic_label<weight2, CU>>
+front(const std::vector<Label> &ls)
+{
+  std::vector<generic_label<weight2, CU>> s(ls.begin(), ls.end());
+  std::ranges::stable_sort(s);
+
+  std::vector<generic_label<weight2, CU>> f;
+  for(const auto &l: s)
+    if (!boe(f, l))
+      f.push_back(l);
+
+  return f;
+}
+
+// One search finds the labels of the Pareto paths for both criteria,
+// and with the bounds on both, those within the bounds.
+void
+test_search()
+{
+  std::mt19937 gen(1);
+
+  for(int k = 0; k < 100; ++k)
+    {
+      auto g = random_graph(8, 24, gen);
+      const unsigned src = 0, dst = 7;
+      const CU r(0, 9);
+      mc_edge ie(g[src], g[src], weight2{0, 0}, r);
+      mc_label initial({weight2{0, 0}, r}, ie);
+
+      std::vector<generic_label<weight2, CU>> all;
+      std::vector<bool> seen(g.size());
+      all_paths(g, src, dst, seen, initial, all);
+
+      generic_permanent<mc_label> P(g.size());
+      generic_tentative<mc_label> T(g.size());
+      std::vector<mc_label> ls;
+      for(const auto &l: generic_search(P, T, mc_functor(), initial, dst))
+        ls.push_back(l);
+
+      // The search yields boe-incomparable labels.
+      assert(front(ls).size() == ls.size());
+      assert(front(ls) == front(all));
+
+      const weight2 cap{15, 15};
+      std::erase_if(all, [&cap](const auto &l)
+      {
+        return !weight_boe(get_weight(l), cap);
+      });
+
+      bounded_functor f(mc_functor(), search_bounds<weight2>{cap});
+      generic_permanent<mc_label> P2(g.size());
+      generic_tentative<mc_label> T2(g.size());
+      std::vector<mc_label> ls2;
+      for(const auto &l: generic_search(P2, T2, f, initial, dst))
+        ls2.push_back(l);
+
+      assert(front(ls2) == front(all));
+    }
+}
+
+int
+main()
+{
+  test_weight_vector();
+  test_search();
+}
@@ -0,0 +1,132 @@
+#ifndef WEIGHT_VECTOR_HPP
+#define WEIGHT_VECTOR_HPP
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+// The weight of several criteria, e.g., the length and the impairment
+// of a path, so that one search finds the paths for all of them.  Use
+// it as the Weight of generic_label, and of the edges.
+//
+// The weights are added component by component.  A weight is better
+// than or equal to another if every component is no larger: see
+// weight_boe.  For the priority queue and the sorted containers, the
+// weights are ordered lexicographically, which agrees with weight_boe:
+// if weight_boe(a, b), then a <= b lexicographically.
+template <typename T, std::size_t N>
+struct weight_vector
+{
+  static_assert(N > 0);
+
+  std::array<T, N> m_c;
+
+  constexpr const T &
+  operator[](std::size_t i) const
+  {
+    return m_c[i];
+  }
+
+  constexpr T &
+  operator[](std::size_t i)
+  {
+    return m_c[i];
+  }
+
+  constexpr bool operator == (const weight_vector &) const = default;
+
+  // The lexicographic order.  The two and three criteria are spelled
+  // out, so that they compile to a few comparisons.
+  constexpr std::strong_ordering
+  operator <=> (const weight_vector &b) const
+    requires std::three_way_comparable<T, std::strong_ordering>
+  {
+    if constexpr (N == 2)
+      {
+        if (m_c[0] != b.m_c[0])
+          return m_c[0] <=> b.m_c[0];
+        return m_c[1] <=> b.m_c[1];
+      }
+    else if constexpr (N == 3)
+      {
+        if (m_c[0] != b.m_c[0])
+          return m_c[0] <=> b.m_c[0];
+        if (m_c[1] != b.m_c[1])
+          return m_c[1] <=> b.m_c[1];
+        return m_c[2] <=> b.m_c[2];
+      }
+    else
+      return m_c <=> b.m_c;
+  }
+
+  constexpr weight_vector &
+  operator += (const weight_vector &b)
+  {
+    for(std::size_t i = 0; i < N; ++i)
+      m_c[i] += b.m_c[i];
+
+    return *this;
+  }
+};
+
+template <typename T, typename... Ts>
+weight_vector(T, Ts...) -> weight_vector<T, 1 + sizeof...(Ts)>;
+
+template <typename T, std::size_t N>
+constexpr weight_vector<T, N>
+operator + (weight_vector<T, N> a, const weight_vector<T, N> &b)
+{
+  return a += b;
+}
+
+// Is weight a better than or equal to weight b: is every component
+// of a no larger than that of b?
+template <typename T, std::size_t N>
+constexpr bool
+weight_boe(const weight_vector<T, N> &a, const weight_vector<T, N> &b)
+{
+  if constexpr (N == 2)
+    return a[0] <= b[0] && a[1] <= b[1];
+  else if constexpr (N == 3)
+    return a[0] <= b[0] && a[1] <= b[1] && a[2] <= b[2];
+  else
+    {
+      for(std::size_t i = 0; i < N; ++i)
+        if (a[i] > b[i])
+          return false;
+
+      return true;
+    }
+}
+
+template <typename T, std::size_t N>
+std::ostream &
+operator<<(std::ostream &out, const weight_vector<T, N> &w)
+{
+  out << "(";
+  for(std::size_t i = 0; i < N; ++i)
+    out << (i ? ", " : "") << w[i];
+  out << ")";
+
+  return out;
+}
+
+// The largest weight is the largest in every component, and so
+// search_bounds has no bound by default for the vectors too.
+template <typename T, std::size_t N>
+struct std::numeric_limits<weight_vector<T, N>>
+{
+  static constexpr bool is_specialized = true;
+
+  static constexpr weight_vector<T, N>
+  max()
+  {
+    weight_vector<T, N> w;
+    w.m_c.fill(std::numeric_limits<T>::max());
+    return w;
+  }
+};
+
+#endif // WEIGHT_VECTOR_HPP